@@ -4,6 +4,11 @@ SDK::FUObjectArray SDK::GUObjectArray = SDK::FUObjectArray();
 SDK::FEngineVersion SDK::Engine_Version = SDK::FEngineVersion();
 SDK::FFortniteVersion SDK::Fortnite_Version = SDK::FFortniteVersion();
 std::unique_ptr<SDK::FKismetPropertyLibrary> SDK::PropLibrary = std::make_unique<SDK::FKismetPropertyLibrary>();
+std::unique_ptr<SDK::FKismetDispatchLibrary> SDK::DispatchLibrary = std::make_unique<SDK::FKismetDispatchLibrary>();
+std::unique_ptr<SDK::FKismetTaskLibrary> SDK::TaskLibrary = std::make_unique<SDK::FKismetTaskLibrary>();
+std::unique_ptr<SDK::FKismetSerializationLibrary> SDK::SerializationLibrary = std::make_unique<SDK::FKismetSerializationLibrary>();
+std::unique_ptr<SDK::FKismetSnapshotLibrary> SDK::SnapshotLibrary = std::make_unique<SDK::FKismetSnapshotLibrary>();
+std::unique_ptr<SDK::FKismetExportLibrary> SDK::ExportLibrary = std::make_unique<SDK::FKismetExportLibrary>();
 
 SDK::uint32 SDK::Offsets::Members::UStruct__SuperStruct = -1;
 SDK::uint32 SDK::Offsets::Members::UStruct__Children = -1;
@@ -102,6 +107,33 @@ bool SDK::Init() {
         logLibrary->Log_Internal( "GUObjectArray Num: %d",
                                   GUObjectArray.GetObjectArrayNum() );
 
+        /*
+        * -------------------------------------------
+        * BEGIN FUObjectArray::AllocateSerialNumber
+        * -------------------------------------------
+        */
+
+        /*Only its overflow check uses the string, the function starts right after the int3 padding above it*/
+        memLibrary->SwitchStringRef(
+            L"UObject serial numbers overflowed (trying to allocate serial number %d).", 0 );
+        if ( memLibrary->GetStatus() != 0 ) {
+                memLibrary->ScanFor( { 0xCC }, false );
+                if ( memLibrary->GetAddress() != 0 ) {
+                        memLibrary->AbsoluteOffset( 1 );
+                        Offsets::FUObjectArray__AllocateSerialNumber =
+                            memLibrary->GetAddress();
+                }
+        }
+        if ( Offsets::FUObjectArray__AllocateSerialNumber ) {
+                logLibrary->Log_Internal( "Found FUObjectArray::AllocateSerialNumber: %p",
+                                          Offsets::FUObjectArray__AllocateSerialNumber );
+        } else {
+                /*Queued calls, serialized references and snapshots refuse objects without a serial then*/
+                logLibrary->Log_Internal(
+                    "Failed to find FUObjectArray::AllocateSerialNumber with "
+                    "`UObject serial numbers overflowed` String Ref" );
+        }
+
         /*
         * -----------------------
         * BEGIN FName::ToString
@@ -121,6 +153,26 @@ bool SDK::Init() {
                 return false;
         }
 
+        /*
+        * ---------------------
+        * BEGIN FName::FName
+        * ---------------------
+        */
+
+        /*The engine builds FName( TEXT( "CanvasObject" ) ), the first call after the string ref is the constructor*/
+        memLibrary->SwitchStringRef( L"CanvasObject", 0 );
+        if ( memLibrary->GetStatus() != 0 ) {
+                memLibrary->ScanFor( { 0xE8 } );
+                memLibrary->RelativeOffset( 1 );
+                Offsets::FName__FName = memLibrary->GetAddress();
+                logLibrary->Log_Internal( "Found FName::FName: %p",
+                                          Offsets::FName__FName );
+        } else {
+                /*Only FName construction from strings depends on it*/
+                logLibrary->Log_Internal(
+                    "Failed to find FName::FName with `CanvasObject` String Ref" );
+        }
+
         /*
         * ---------------------
         * BEGIN FMemory::Realloc
@@ -196,7 +248,8 @@ bool SDK::Init() {
         static FString &( *GetEngineVersion )( FString &retstr ) =
             decltype( GetEngineVersion )( memLibrary->GetAddress() );
 
-        FString TempString = GetEngineVersion( TempString );
+        FString TempString;
+        GetEngineVersion( TempString );
 
         if (TempString.ToString().contains("Live") ||
             TempString.ToString().contains("Cert"))
@@ -231,6 +284,19 @@ bool SDK::Init() {
             "FortniteVersion: %s",
             SDK::Fortnite_Version.ToString().c_str() );
 
+        /*
+        * ---------------------
+        * BEGIN GMalloc
+        * ---------------------
+        */
+        /*After the version, the FMalloc vtable layout depends on it. Malloc and Free go through Realloc until then*/
+        if ( SDK::FMemory::ResolveFromRealloc() ) {
+                logLibrary->Log_Internal( "Found GMalloc: %p", Offsets::GMalloc );
+        } else {
+                logLibrary->Log_Internal(
+                    "Failed to find GMalloc from FMemory::Realloc" );
+        }
+
         /*
         * ------------------------
         * BEGIN MemberOffsets
@@ -21,16 +21,38 @@
 #include <locale>
 #include <chrono>
 #include <unordered_set>
+#include <shared_mutex>
+#include <string_view>
+#include <new>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <coroutine>
+#include <bit>
+#include <emmintrin.h>
+#include <charconv>
+#include <memory_resource>
 #include "sdk/memcury.h"
 #include "sdk/Offsets.h"
 #include "sdk/KismetMemoryLibrary.h"
 #include "sdk/KismetLogLibrary.h"
 #include "sdk/Memory.h"
+#include "sdk/ReadableMemory.h"
 #include "sdk/Math.h"
 #include "sdk/Version.h"
+#include "sdk/StringConv.h"
+#include "sdk/ArraySearch.h"
+#include "sdk/MemStack.h"
 #include "UnrealContainers.h"
 #include "sdk/CoreObject_classes.h"
+#include "sdk/Property_classes.h"
 #include "sdk/KismetPropertyLibrary.h"
+#include "sdk/KismetDispatchLibrary.h"
+#include "sdk/Stack.h"
+#include "sdk/KismetTaskLibrary.h"
+#include "sdk/KismetSerializationLibrary.h"
+#include "sdk/KismetSnapshotLibrary.h"
+#include "sdk/KismetExportLibrary.h"
 
 
 namespace SDK 
@@ -40,6 +62,7 @@ bool Init();
 
 extern FUObjectArray GUObjectArray;
 extern std::unique_ptr<FKismetPropertyLibrary> PropLibrary;
+extern std::unique_ptr<FKismetDispatchLibrary> DispatchLibrary;
 extern FEngineVersion Engine_Version;
 extern FFortniteVersion Fortnite_Version;
 
@@ -50,85 +73,25 @@ extern FFortniteVersion Fortnite_Version;
 template <class T>
 T& SDK::UObject::Get( const std::string &ClassName,
                      const std::string &PropName ) {
-        SDK::FPropertyInfo PropInfo =
+        const SDK::FPropertyInfo &PropInfo =
             PropLibrary->GetPropertyByName( ClassName,
                                                            PropName );
 
-        if ( PropInfo.Offset != -1 ) {
+        if ( PropInfo.Offset != -1 &&
+             SDK::IsPropertySizeCompatible<T>( PropInfo.Ref ) ) {
                 return *reinterpret_cast<T *>(
                     reinterpret_cast<uintptr_t>( this ) + PropInfo.Offset );
         } else {
                 UE_LOG( LogGetterSetter, Log, "Failed to get %s from class %s",
                         PropName.c_str(), ClassName.c_str() );
 
-                if constexpr ( std::is_pointer<T>::value )
-                        return nullptr;
-                else {
-                        T Variable = T{};
-                        return Variable;
-                }
-
+                /*Handed out by reference, so it can't be a local*/
+                static thread_local T Variable;
+                Variable = T{};
+                return Variable;
         }
 }
 
-static std::vector<std::string> GetParamNames( SDK::UFunction *fn ) {
-        std::vector<std::string> ParamNames;
-        std::unordered_set<std::string> Seen;
-
-        auto TryAdd = [&]( const std::string &name ) {
-                if ( Seen.insert( name ).second )
-                        ParamNames.push_back( name );
-        };
-
-        if ( SDK::UEChanges::bUsesFPropertySystem ) {
-                if ( SDK::UEChanges::bUsesUE5FProp ) {
-                        SDK::FProperty500 *Prop = nullptr;
-                        fn->GetPropertyLink( &Prop );
-                        for ( ; Prop; Prop = Prop->PropertyLinkNext ) {
-                                TryAdd(
-                                    Prop->NamePrivate.ToString().ToString() );
-                        }
-                } else {
-                        SDK::FProperty *Prop = nullptr;
-                        fn->GetPropertyLink( &Prop );
-                        for ( ; Prop; Prop = Prop->PropertyLinkNext ) {
-                                TryAdd(
-                                    Prop->NamePrivate.ToString().ToString() );
-                        }
-                }
-        } else {
-                SDK::UProperty *Prop = nullptr;
-                fn->GetPropertyLink( &Prop );
-                for ( ; Prop; Prop = Prop->PropertyLinkNext ) {
-                        TryAdd( Prop->GetFName().ToString().ToString() );
-                }
-        }
-
-        const static bool bUseChildProperties =
-            SDK::Offsets::Members::UStruct__ChildProperties != -1;
-
-        if ( bUseChildProperties ) {
-                for ( SDK::FField *Next = fn->GetChildrenProperties(); Next;
-                      Next = Next->Next ) {
-                        SDK::FProperty *NextProp =
-                            reinterpret_cast<SDK::FProperty *>( Next );
-                        TryAdd( NextProp->NamePrivate.ToString().ToString() );
-                }
-        } else {
-                for ( SDK::UField *Next = fn->GetChildren(); Next;
-                      Next = Next->Next ) {
-                        if ( !Next->GetClass() || Next->IsA<SDK::UFunction>() )
-                                continue;
-
-                        SDK::UProperty *NextProp =
-                            reinterpret_cast<SDK::UProperty *>( Next );
-                        TryAdd( NextProp->GetFName().ToString().ToString() );
-                }
-        }
-
-        return ParamNames;
-}
-
 template <typename Ret, typename T, typename... Args, size_t... Is>
 Ret CallFunc_Impl( T *Obj, const std::string &className,
                    const std::string &functionName,
@@ -145,15 +108,13 @@ Ret CallFunc_Impl( T *Obj, const std::string &className,
                         return;
         }
 
-        const size_t paramSize = fn->GetSize();
-        uint8_t *buffer = (uint8_t *)malloc( paramSize );
-        std::memset( buffer, 0, paramSize );
+        const SDK::FFunctionParamsInfo *ParamsInfo =
+            SDK::PropLibrary->GetFunctionParamsInfo( fn );
 
-        auto Params = GetParamNames( fn );
+        SDK::FFunctionParamsFrame Frame( ParamsInfo );
+        uint8_t *buffer = Frame.GetData();
 
-        for ( auto &Param : Params ) {
-                UE_LOG( LogFortSDK, VeryVerbose, "Param: %s", Param.c_str() );
-        }
+        const auto &Params = ParamsInfo->Params;
         size_t i = 0;
         (
             [&] {
@@ -164,44 +125,44 @@ Ret CallFunc_Impl( T *Obj, const std::string &className,
                             return;
                     }
 
-                    const std::string &argName = Params[i];
-                    const auto &propInfo = SDK::PropLibrary->GetPropertyByName(
-                        functionName, argName );
-                    if ( propInfo.Offset != -1 ) {
-                            const auto &arg = std::get<Is>( argsTuple );
-                            std::memcpy( buffer + propInfo.Offset, &arg,
-                                         sizeof( arg ) );
-                            UE_LOG( LogFortSDK, VeryVerbose,
-                                    "Arg[%zu] %s -> offset %d, size %zu", i,
-                                    argName.c_str(), propInfo.Offset,
-                                    sizeof( arg ) );
-                    } else {
-                            UE_LOG(
-                                LogFortSDK, Warning,
-                                "Failed to find property for arg %s in %s::%s",
-                                argName.c_str(), className.c_str(),
-                                functionName.c_str() );
-                    }
+                    const SDK::FParamInfo &Param = Params[i];
+                    const auto &arg = std::get<Is>( argsTuple );
+                    /*Never write past the reflected param, the next one or the frame's end is right behind it*/
+                    if ( sizeof( arg ) != size_t( Param.Size ) )
+                            UE_LOG( LogFortSDK, Warning,
+                                    "CallFunc argument %zu of %s::%s is %zu bytes, "
+                                    "reflected size is %d",
+                                    i, className.c_str(), functionName.c_str(),
+                                    sizeof( arg ), Param.Size );
+                    std::memcpy( buffer + Param.Offset, &arg,
+                                 (std::min)( sizeof( arg ), size_t( Param.Size ) ) );
+                    Frame.MarkCallerOwned( i );
+                    UE_LOG( LogFortSDK, VeryVerbose,
+                            "Arg[%zu] -> offset %d, size %zu", i, Param.Offset,
+                            sizeof( arg ) );
                     ++i;
             }(),
             ... );
 
-        auto Flgs = fn->FunctionFlags();
-        fn->FunctionFlags() |= 0x400;
         if ( Obj )
-                Obj->ProcessEvent( fn, buffer );
-        fn->FunctionFlags() = Flgs;
+                Obj->ProcessEventAsNative( fn, buffer, ParamsInfo );
 
         if constexpr ( !std::is_void_v<Ret> ) {
-                const auto &retProp = SDK::PropLibrary->GetPropertyByName(
-                    functionName, "ReturnValue" );
+                const SDK::FParamInfo &RetParam = ParamsInfo->ReturnValue;
                 Ret result{};
-                if ( retProp.Offset != -1 ) {
-                        std::memcpy( &result, buffer + retProp.Offset,
-                                     sizeof( Ret ) );
+                if ( RetParam.Offset != -1 ) {
+                        if ( sizeof( Ret ) != size_t( RetParam.Size ) )
+                                UE_LOG( LogFortSDK, Warning,
+                                        "CallFunc return type of %s::%s is %zu bytes, "
+                                        "reflected size is %d",
+                                        className.c_str(), functionName.c_str(),
+                                        sizeof( Ret ), RetParam.Size );
+                        std::memcpy( &result, buffer + RetParam.Offset,
+                                     (std::min)( sizeof( Ret ), size_t( RetParam.Size ) ) );
+                        Frame.ReleaseReturnValue();
                         UE_LOG( LogFortSDK, VeryVerbose,
                                 "ReturnValue copied from offset %d",
-                                retProp.Offset );
+                                RetParam.Offset );
                 } else {
                         UE_LOG(
                             LogFortSDK, Warning,
@@ -225,14 +186,15 @@ Ret SDK::UObject::CallFunc(const std::string& ClassName,
 template <typename T>
 void SDK::UObject::Set(const std::string& ClassName,
     const std::string& PropName, const T& Value) {
-        SDK::FPropertyInfo PropInfo =
+        const SDK::FPropertyInfo &PropInfo =
             PropLibrary->GetPropertyByName( ClassName, PropName );
 
         if ( !this ) {
                 return;
         }
 
-        if ( PropInfo.Offset != -1 ) {
+        if ( PropInfo.Offset != -1 &&
+             SDK::IsPropertySizeCompatible<T>( PropInfo.Ref ) ) {
                 UE_LOG( LogGetterSetter, VeryVerbose, "Found: %s, %d",
                         PropName.c_str(), PropInfo.Offset );
                 *reinterpret_cast<T *>(
@@ -243,4 +205,6 @@ void SDK::UObject::Set(const std::string& ClassName,
 
                 return;
         }
-}
\ No newline at end of file
+}
+
+#include "sdk/FunctionCaller.h"
@@ -1,6 +1,7 @@
 #pragma once
 #include <cassert>
 #include <cmath>
+#include <tuple>
 
 template <typename A, typename B> struct TAreTypesEqual;
 
@@ -169,8 +170,6 @@ FORCEINLINE int32_t DefaultCalculateSlackGrow( int32_t NumElements,
                 Retval = INT32_MAX;
         }
 
-        printf( "RetVal: %d\n", Retval );
-
         return Retval;
 }
 
@@ -320,6 +319,127 @@ struct TCheckedPointerIterator {
         }
 };
 
+/**
+ * Array view whose element stride is only known at runtime.
+ * Engine arrays of script structs hold elements of the size reflection
+ * reports, not sizeof( ElementType ), so indexing has to step by that size.
+ * Range-for prefetches a few elements ahead since the stride defeats the
+ * hardware prefetcher less often than a pointer chase but still benefits.
+ *
+ * for ( uint8 &Element : ArrayProp.GetView<uint8>( Object ) ) ...
+ */
+template <typename InElementType> class TStridedArrayView {
+      public:
+        typedef InElementType ElementType;
+        typedef std::conditional_t<std::is_const_v<InElementType>, const uint8,
+                                   uint8>
+            ByteType;
+
+        /** How many elements ahead range-for prefetches. */
+        static constexpr int32 PrefetchDistance = 4;
+
+        FORCEINLINE TStridedArrayView()
+            : Data( nullptr ), ArrayNum( 0 ), Stride( sizeof( ElementType ) ) {}
+
+        FORCEINLINE TStridedArrayView( ElementType *InData, int32 InNum,
+                                       int32 InStride = sizeof( ElementType ) )
+            : Data( reinterpret_cast<ByteType *>( InData ) ), ArrayNum( InNum ),
+              Stride( InStride ) {}
+
+        FORCEINLINE int32 Num() const { return ArrayNum; }
+        FORCEINLINE int32 GetStride() const { return Stride; }
+        FORCEINLINE bool IsEmpty() const { return ArrayNum == 0; }
+
+        FORCEINLINE bool IsValidIndex( int32 Index ) const {
+                return Index >= 0 && Index < ArrayNum;
+        }
+
+        FORCEINLINE ElementType &operator[]( int32 Index ) const {
+                checkSlow( IsValidIndex( Index ) );
+                return *reinterpret_cast<ElementType *>(
+                    Data + ptrdiff_t( Index ) * Stride );
+        }
+
+        class TIterator {
+              public:
+                FORCEINLINE TIterator( ByteType *InPtr, int32 InStride )
+                    : Ptr( InPtr ), Stride( InStride ) {}
+
+                FORCEINLINE ElementType &operator*() const {
+                        return *reinterpret_cast<ElementType *>( Ptr );
+                }
+                FORCEINLINE ElementType *operator->() const {
+                        return reinterpret_cast<ElementType *>( Ptr );
+                }
+                FORCEINLINE ElementType &operator[]( int32 Offset ) const {
+                        return *reinterpret_cast<ElementType *>(
+                            Ptr + ptrdiff_t( Offset ) * Stride );
+                }
+
+                FORCEINLINE TIterator &operator++() {
+                        Ptr += Stride;
+                        /*Prefetches don't fault, running past the end is fine*/
+                        _mm_prefetch( reinterpret_cast<const char *>(
+                                          Ptr + ptrdiff_t( PrefetchDistance ) *
+                                                    Stride ),
+                                      _MM_HINT_T0 );
+                        return *this;
+                }
+                FORCEINLINE TIterator &operator--() {
+                        Ptr -= Stride;
+                        return *this;
+                }
+                FORCEINLINE TIterator &operator+=( int32 Offset ) {
+                        Ptr += ptrdiff_t( Offset ) * Stride;
+                        return *this;
+                }
+                FORCEINLINE TIterator &operator-=( int32 Offset ) {
+                        Ptr -= ptrdiff_t( Offset ) * Stride;
+                        return *this;
+                }
+                FORCEINLINE TIterator operator+( int32 Offset ) const {
+                        return TIterator( *this ) += Offset;
+                }
+                FORCEINLINE TIterator operator-( int32 Offset ) const {
+                        return TIterator( *this ) -= Offset;
+                }
+                FORCEINLINE int32 operator-( const TIterator &Other ) const {
+                        return int32( ( Ptr - Other.Ptr ) / Stride );
+                }
+
+                FORCEINLINE bool operator==( const TIterator &Other ) const {
+                        return Ptr == Other.Ptr;
+                }
+                FORCEINLINE bool operator!=( const TIterator &Other ) const {
+                        return Ptr != Other.Ptr;
+                }
+                FORCEINLINE bool operator<( const TIterator &Other ) const {
+                        return Ptr < Other.Ptr;
+                }
+
+              private:
+                ByteType *Ptr;
+                int32 Stride;
+        };
+
+        FORCEINLINE TIterator begin() const {
+                for ( int32 i = 0; i < PrefetchDistance && i < ArrayNum; i++ )
+                        _mm_prefetch( reinterpret_cast<const char *>(
+                                          Data + ptrdiff_t( i ) * Stride ),
+                                      _MM_HINT_T0 );
+                return TIterator( Data, Stride );
+        }
+        FORCEINLINE TIterator end() const {
+                return TIterator( Data + ptrdiff_t( ArrayNum ) * Stride,
+                                  Stride );
+        }
+
+      private:
+        ByteType *Data;
+        int32 ArrayNum;
+        int32 Stride;
+};
+
 template <typename InElementType> class TArray {
 
       public:
@@ -333,6 +453,34 @@ template <typename InElementType> class TArray {
          */
         FORCEINLINE TArray() : Data( nullptr ), ArrayNum( 0 ), ArrayMax( 0 ) {}
 
+        /**
+         * Copies share the allocation, a TArray never frees on its own since
+         * most of them are views into engine memory.
+         */
+        TArray( const TArray & ) = default;
+        TArray &operator=( const TArray & ) = default;
+
+        /** Takes Other's allocation and leaves Other empty. */
+        FORCEINLINE TArray( TArray &&Other ) noexcept
+            : Data( Other.Data ), ArrayNum( Other.ArrayNum ),
+              ArrayMax( Other.ArrayMax ) {
+                Other.Data = nullptr;
+                Other.ArrayNum = 0;
+                Other.ArrayMax = 0;
+        }
+
+        FORCEINLINE TArray &operator=( TArray &&Other ) noexcept {
+                if ( this != &Other ) {
+                        Data = Other.Data;
+                        ArrayNum = Other.ArrayNum;
+                        ArrayMax = Other.ArrayMax;
+                        Other.Data = nullptr;
+                        Other.ArrayNum = 0;
+                        Other.ArrayMax = 0;
+                }
+                return *this;
+        }
+
       protected:
         ElementType *Data;
         int32 ArrayNum;
@@ -359,7 +507,8 @@ template <typename InElementType> class TArray {
 
         FORCEINLINE ElementType &GetData( int32 Index,
                                           int32 ElementSize = sizeof( ElementType) ) {
-                return Data[Index];
+                return *reinterpret_cast<ElementType *>(
+                    reinterpret_cast<uint8 *>( Data ) + Index * ElementSize );
         }
 
         FORCEINLINE const ElementType &
@@ -370,6 +519,21 @@ template <typename InElementType> class TArray {
                     Index * ElementSize );
         }
 
+        /**
+         * View over the elements stepping by ElementSize, pass the reflected
+         * size when the elements aren't really sizeof( ElementType ).
+         */
+        FORCEINLINE TStridedArrayView<ElementType>
+        GetView( int32 ElementSize = sizeof( ElementType ) ) {
+                return TStridedArrayView<ElementType>( Data, ArrayNum,
+                                                       ElementSize );
+        }
+        FORCEINLINE TStridedArrayView<const ElementType>
+        GetView( int32 ElementSize = sizeof( ElementType ) ) const {
+                return TStridedArrayView<const ElementType>( Data, ArrayNum,
+                                                             ElementSize );
+        }
+
         /**
          * Helper function returning the size of the inner type.
          *
@@ -420,7 +584,7 @@ template <typename InElementType> class TArray {
          * @see FindLast, FindLastByPredicate
          */
 
-        FORCEINLINE bool Find( const ElementType &Item, int32 Index ) const {
+        FORCEINLINE bool Find( const ElementType &Item, int32 &Index ) const {
                 Index = this->Find( Item );
                 return Index != -1;
         }
@@ -428,94 +592,117 @@ template <typename InElementType> class TArray {
         /**
          * Finds element within the array.
          *
+         * Element types that compare bytewise (see TIsBitwiseComparable) go
+         * through the SIMD kernels in ArraySearch.
+         *
          * @param Item Item to look for.
          * @returns Index of the found element. INDEX_NONE otherwise.
          * @see FindLast, FindLastByPredicate
          */
         int32 Find( const ElementType &Item ) const {
-                for ( int i = 0; i < ArrayNum; i++ ) {
-                        if ( Data[i] == Item ) {
-                                return static_cast<int32>( i );
+                if constexpr ( TIsBitwiseComparable<ElementType> &&
+                               ( sizeof( ElementType ) == 4 ||
+                                 sizeof( ElementType ) == 8 ) ) {
+                        return ArraySearch::FindFirst( GetData(), ArrayNum, Item );
+                } else {
+                        for ( int i = 0; i < ArrayNum; i++ ) {
+                                if ( Data[i] == Item ) {
+                                        return static_cast<int32>( i );
+                                }
                         }
-                }
 
-                return -1;
+                        return -1;
+                }
         }
 
         FORCEINLINE bool FindLast( const ElementType &Item,
-                                   int32 Index ) const {
+                                   int32 &Index ) const {
                 Index = this->FindLast( Item );
                 return Index != -1;
         }
 
         int32 FindLast( const ElementType &Item ) const {
-                for ( int i = ArrayNum; i > 0; i-- ) {
-                        if ( Data[i] == Item ) {
-                                return static_cast<int32>( i );
+                if constexpr ( TIsBitwiseComparable<ElementType> &&
+                               ( sizeof( ElementType ) == 4 ||
+                                 sizeof( ElementType ) == 8 ) ) {
+                        return ArraySearch::FindLast( GetData(), ArrayNum, Item );
+                } else {
+                        for ( int i = ArrayNum - 1; i >= 0; i-- ) {
+                                if ( Data[i] == Item ) {
+                                        return static_cast<int32>( i );
+                                }
                         }
+
+                        return -1;
                 }
+        }
 
-                return -1;
+        FORCEINLINE bool Contains( const InElementType &Item ) const {
+                return Find( Item ) != -1;
         }
 
-        bool Contains( const InElementType &Item ) const {
-                for ( int i = 0; i < ArrayNum; i++ ) {
-                        if ( Data[i] == Item ) {
-                                return true;
-                        }
-                }
+        /**
+         * Grows the allocation after ArrayNum went past ArrayMax, using the
+         * engine's slack policy so N adds cost O(log N) reallocations.
+         * Realloc moves the old elements itself.
+         */
+        FORCEINLINE void ResizeGrow( int32 OldNum, int32 ElementSize = sizeof(ElementType) ) {
+                ResizeTo( DefaultCalculateSlackGrow( ArrayNum, ArrayMax,
+                                                     ElementSize, false ),
+                          ElementSize );
+        }
 
-                return false;
+        /** Reallocates to exactly NewMax elements. */
+        FORCEINLINE void ResizeTo( int32 NewMax,
+                                   int32 ElementSize = sizeof( ElementType ) ) {
+                if ( NewMax == ArrayMax )
+                        return;
+
+                Data = (ElementType *)FMemory::Realloc(
+                    Data, uint64( NewMax ) * ElementSize,
+                    alignof( ElementType ) );
+                ArrayMax = NewMax;
         }
 
-        FORCEINLINE void ResizeGrow( int32 OldNum, int32 ElementSize = sizeof(ElementType) ) {
-                ArrayMax = DefaultCalculateSlackGrow(
-                    ArrayNum, ArrayMax, ElementSize, false );
-                ElementType *OldData = Data;
-                if ( ArrayMax ) {
-                        Data = (ElementType *)FMemory::Realloc(
-                            Data,
-                            ( ArrayMax = ArrayNum + OldNum ) *
-                                ElementSize,
-                            alignof( ElementType ) );
-
-                        if ( OldData && OldNum ) {
-                                const int32 NumCopiedElements =
-                                    FMath::Min( ArrayMax, OldNum );
-                                memcpy( Data, OldData,
-                                        NumCopiedElements *
-                                            ElementSize );
-                        }
-                }
+        /** Makes room for Number elements without touching Num. */
+        FORCEINLINE void Reserve( int32 Number,
+                                  int32 ElementSize = sizeof( ElementType ) ) {
+                if ( Number > ArrayMax )
+                        ResizeTo( Number, ElementSize );
         }
 
         FORCEINLINE int32 AddUnitalized( int32 Count = 1, int32 ElementSize = sizeof(ElementType) ) {
-                if ( Count >= 0 ) {
-                        const int32 OldNum = ArrayNum;
-                        if ( ( ArrayNum += Count ) > ArrayMax ) {
-                                ResizeGrow( OldNum,ElementSize );
-                        }
+                check( Count >= 0 );
 
-                        return OldNum;
+                const int32 OldNum = ArrayNum;
+                if ( ( ArrayNum += Count ) > ArrayMax ) {
+                        ResizeGrow( OldNum, ElementSize );
                 }
+
+                return OldNum;
         }
 
         FORCEINLINE int32 Emplace( InElementType &Item,
                                    int32 ElementSize = sizeof( ElementType ) ) {
-                const int32 Index = AddUnitalized( 1,ElementSize );
-                memcpy_s( (InElementType *)( __int64( Data ) +
-                                             ( ArrayNum * ElementSize ) ),
-                          ElementSize, (void *)&Item, ElementSize );
-
-                return Index;
+                return Emplace( const_cast<const InElementType &>( Item ),
+                                ElementSize );
         }
 
         FORCEINLINE int32 Emplace( const InElementType &Item,
                                    int32 ElementSize = sizeof( ElementType ) ) {
-                const int32 Index = AddUnitalized( 1 );
-                memcpy_s( (InElementType *)( __int64( Data ) +
-                                             ( ArrayNum * ElementSize ) ),
-                          ElementSize, (void *)&Item, ElementSize );
+                /*Item may live in this array, find it again if growing moves the allocation*/
+                const uintptr_t ItemAddress = uintptr_t( &Item );
+                const uintptr_t DataAddress = uintptr_t( Data );
+                const bool bItemInArray =
+                    ItemAddress >= DataAddress &&
+                    ItemAddress < DataAddress + uintptr_t( ArrayMax ) * ElementSize;
+
+                const int32 Index = AddUnitalized( 1, ElementSize );
+                const void *Source =
+                    bItemInArray ? reinterpret_cast<uint8 *>( Data ) +
+                                       ( ItemAddress - DataAddress )
+                                 : static_cast<const void *>( &Item );
+                memcpy( &GetData( Index, ElementSize ), Source, ElementSize );
 
                 return Index;
         }
@@ -523,30 +710,69 @@ template <typename InElementType> class TArray {
         FORCEINLINE ElementType &
         Emplace_GetRef( InElementType &Item,
                         int32 ElementSize = sizeof( ElementType ) ) {
-                const int32 Index = AddUnitalized( 1 );
-                memcpy_s( (InElementType *)( __int64( Data ) +
-                                             ( ArrayNum * ElementSize ) ),
-                          ElementSize, (void *)&Item, ElementSize );
-                return Data[Index];
+                return GetData( Emplace( Item, ElementSize ), ElementSize );
         }
 
         FORCEINLINE int32 Add( InElementType &Item,
                                int32 ElementSize = sizeof( ElementType ) ) {
-                if ( &Item )
-                        return Emplace( Item, ElementSize );
+                return Emplace( Item, ElementSize );
         }
 
         FORCEINLINE int32 Add( const ElementType &Item, int32 ElementSize = sizeof(ElementType) ) {
-                if ( &Item )
-                        return Emplace( Item,ElementSize );
+                return Emplace( Item, ElementSize );
         }
 
         FORCEINLINE ElementType &
         Add_GetRef( ElementType &Item,
                     int32 ElementSize = sizeof( ElementType ) ) {
-                if ( &Item ) {
-                        return Emplace_GetRef( Item,ElementSize );
+                return Emplace_GetRef( Item, ElementSize );
+        }
+
+        /**
+         * Appends Count elements laid out ElementSize apart with at most one
+         * reallocation.
+         *
+         * @returns Index of the first appended element.
+         */
+        int32 Append( const ElementType *Items, int32 Count,
+                      int32 ElementSize = sizeof( ElementType ) ) {
+                check( Count >= 0 );
+
+                const int32 OldNum = ArrayNum;
+                if ( Count == 0 )
+                        return OldNum;
+
+                /*Items may be this array or part of it (A.Append( A )), find it again if growing moves the allocation*/
+                const uintptr_t ItemsAddress = uintptr_t( Items );
+                const uintptr_t DataAddress = uintptr_t( Data );
+                const bool bItemsInArray =
+                    ItemsAddress >= DataAddress &&
+                    ItemsAddress < DataAddress + uintptr_t( ArrayMax ) * ElementSize;
+
+                if ( OldNum + Count > ArrayMax ) {
+                        ResizeTo( DefaultCalculateSlackGrow(
+                                      OldNum + Count, ArrayMax, ElementSize,
+                                      false ),
+                                  ElementSize );
                 }
+                const void *Source =
+                    bItemsInArray ? reinterpret_cast<uint8 *>( Data ) +
+                                        ( ItemsAddress - DataAddress )
+                                  : static_cast<const void *>( Items );
+                memcpy( &GetData( OldNum, ElementSize ), Source,
+                        size_t( Count ) * ElementSize );
+                ArrayNum += Count;
+
+                return OldNum;
+        }
+
+        FORCEINLINE int32 Append( const TArray &Other,
+                                  int32 ElementSize = sizeof( ElementType ) ) {
+                return Append( Other.GetData(), Other.Num(), ElementSize );
+        }
+
+        FORCEINLINE int32 Append( std::initializer_list<ElementType> Items ) {
+                return Append( Items.begin(), int32( Items.size() ) );
         }
 
         inline bool Remove( int32 Index ) {
@@ -559,6 +785,31 @@ template <typename InElementType> class TArray {
                         int32 NextIndex = i + 1;
                         Data[i] = Data[NextIndex];
                 }
+
+                return true;
+        }
+
+        /**
+         * Removes Count elements at Index by moving the last elements into
+         * the hole, O(Count) instead of shifting everything after it. Doesn't
+         * keep the order.
+         */
+        bool RemoveAtSwap( int32 Index, int32 Count = 1,
+                           int32 ElementSize = sizeof( ElementType ) ) {
+                if ( Count <= 0 || !IsValidIndex( Index ) ||
+                     Index + Count > ArrayNum )
+                        return false;
+
+                const int32 NumAfterHole = ArrayNum - ( Index + Count );
+                const int32 NumToMove = FMath::Min( Count, NumAfterHole );
+                if ( NumToMove ) {
+                        memcpy( &GetData( Index, ElementSize ),
+                                &GetData( ArrayNum - NumToMove, ElementSize ),
+                                size_t( NumToMove ) * ElementSize );
+                }
+                ArrayNum -= Count;
+
+                return true;
         }
 
         int32 RemoveSingle( const ElementType &Item ) {
@@ -626,7 +877,7 @@ template <typename InElementType> class TArray {
         }
 };
 
-template <typename T> struct TTupleBaseElement {
+template <typename T, uint32 Index> struct TTupleBaseElement {
         TTupleBaseElement( TTupleBaseElement && ) = default;
         TTupleBaseElement( const TTupleBaseElement & ) = default;
         TTupleBaseElement &operator=( TTupleBaseElement && ) = default;
@@ -637,15 +888,38 @@ template <typename T> struct TTupleBaseElement {
         T Value;
 };
 
-template <typename... Types> struct TTupleBase : TTupleBaseElement<Types> {
+template <typename Indices, typename... Types> struct TTupleBase;
+
+/** Each element gets its own base keyed by index, so repeated types don't collide. */
+template <uint32... Indices, typename... Types>
+struct TTupleBase<std::integer_sequence<uint32, Indices...>, Types...>
+    : TTupleBaseElement<Types, Indices>... {
         TTupleBase() = default;
         TTupleBase( TTupleBase &&Other ) = default;
         TTupleBase( const TTupleBase &Other ) = default;
         TTupleBase &operator=( TTupleBase &&Other ) = default;
         TTupleBase &operator=( const TTupleBase &Other ) = default;
+
+        template <uint32 Index> FORCEINLINE auto &Get() {
+                using ElementType =
+                    std::tuple_element_t<Index, std::tuple<Types...>>;
+                return static_cast<TTupleBaseElement<ElementType, Index> &>(
+                           *this )
+                    .Value;
+        }
+        template <uint32 Index> FORCEINLINE const auto &Get() const {
+                using ElementType =
+                    std::tuple_element_t<Index, std::tuple<Types...>>;
+                return static_cast<const TTupleBaseElement<ElementType, Index>
+                                       &>( *this )
+                    .Value;
+        }
 };
 
-template <typename... Types> struct TTuple : TTupleBase<Types> {
+template <typename... Types>
+struct TTuple
+    : TTupleBase<std::make_integer_sequence<uint32, sizeof...( Types )>,
+                 Types...> {
       public:
         TTuple() = default;
         TTuple( TTuple && ) = default;
@@ -654,6 +928,33 @@ template <typename... Types> struct TTuple : TTupleBase<Types> {
         TTuple &operator=( const TTuple & ) = default;
 };
 
+/** Two element tuples name their members like the engine does, this is what a TMap stores. */
+template <typename KeyType, typename ValueType>
+struct TTuple<KeyType, ValueType> {
+      public:
+        TTuple() : Key(), Value() {}
+        TTuple( TTuple && ) = default;
+        TTuple( const TTuple & ) = default;
+        TTuple &operator=( TTuple && ) = default;
+        TTuple &operator=( const TTuple & ) = default;
+
+        template <uint32 Index> FORCEINLINE auto &Get() {
+                if constexpr ( Index == 0 )
+                        return Key;
+                else
+                        return Value;
+        }
+        template <uint32 Index> FORCEINLINE const auto &Get() const {
+                if constexpr ( Index == 0 )
+                        return Key;
+                else
+                        return Value;
+        }
+
+        KeyType Key;
+        ValueType Value;
+};
+
 template <typename KeyType, typename ValueType>
 using TPair = TTuple<KeyType, ValueType>;
 
@@ -796,6 +1097,19 @@ class TBitArray {
                 return (uint32 *)AllocatorInstance.GetAllocation();
         }
 
+        FORCEINLINE int32 Num() const { return NumBits; }
+
+        FORCEINLINE bool IsValidIndex( int32 Index ) const {
+                return Index >= 0 && Index < NumBits;
+        }
+
+        FORCEINLINE bool operator[]( int32 Index ) const {
+                checkSlow( IsValidIndex( Index ) );
+                return ( GetData()[Index / NumBitsPerDWORD] >>
+                         ( Index % NumBitsPerDWORD ) ) &
+                       1;
+        }
+
       private:
         TInlineAllocator<4>::ForElementType<int32> AllocatorInstance;
         int32 NumBits;
@@ -850,7 +1164,66 @@ class TBitArray {
         void Reset() { NumBits = 0; }
 };
 
+/**
+ * Walks the set bits of a TBitArray a word at a time.
+ * Zero words are skipped with one compare and each set bit inside a word is
+ * pulled out with FBitSet::GetAndClearNextBit, so a sparse array with lots of
+ * free slots doesn't cost a test per slot.
+ */
+class TConstSetBitIterator {
+      public:
+        explicit TConstSetBitIterator( const TBitArray &InArray,
+                                       int32 StartIndex = 0 )
+            : Words( InArray.GetData() ), NumBits( InArray.Num() ),
+              WordIndex( StartIndex / NumBitsPerDWORD ), Mask( 0 ),
+              Index( NumBits ) {
+                if ( StartIndex < NumBits ) {
+                        /*Drop the bits below StartIndex in the first word*/
+                        Mask = Words[WordIndex] &
+                               ( ~0u << ( StartIndex % NumBitsPerDWORD ) );
+                        FindNext();
+                }
+        }
+
+        FORCEINLINE TConstSetBitIterator &operator++() {
+                FindNext();
+                return *this;
+        }
+
+        FORCEINLINE explicit operator bool() const { return Index < NumBits; }
+
+        /** Index of the current set bit, Num() once the end is reached. */
+        FORCEINLINE int32 GetIndex() const { return Index; }
+
+      private:
+        FORCEINLINE void FindNext() {
+                const int32 NumWords = int32( FBitSet::CalculateNumWords( NumBits ) );
+                while ( Mask == 0 ) {
+                        if ( ++WordIndex >= NumWords ) {
+                                Index = NumBits;
+                                return;
+                        }
+                        Mask = Words[WordIndex];
+                }
+
+                Index = WordIndex * NumBitsPerDWORD +
+                        int32( FBitSet::GetAndClearNextBit( Mask ) );
+                /*Slack bits past NumBits are meant to be clear, don't trust it*/
+                if ( Index >= NumBits )
+                        Index = NumBits;
+        }
+
+        const uint32 *Words;
+        int32 NumBits;
+        int32 WordIndex;
+        uint32 Mask;
+        int32 Index;
+};
+
 template <typename InElementType> class TSparseArray {
+      public:
+        typedef InElementType ElementType;
+
       private:
         typedef TSparseArrayElementOrFreeListLink<
             TAlignedBytes<sizeof( InElementType ), alignof( InElementType )>>
@@ -867,6 +1240,80 @@ template <typename InElementType> class TSparseArray {
                 return ( (FElementOrFreeListLink *)Data.GetData() )[Index];
         }
 
+        /** Number of allocated elements. */
+        FORCEINLINE int32 Num() const { return Data.Num() - NumFreeIndices; }
+
+        /** One past the highest index that may be allocated. */
+        FORCEINLINE int32 GetMaxIndex() const { return Data.Num(); }
+
+        FORCEINLINE bool IsAllocated( int32 Index ) const {
+                return Index >= 0 && Index < AllocationFlags.Num() &&
+                       AllocationFlags[Index];
+        }
+
+        FORCEINLINE ElementType &operator[]( int32 Index ) {
+                checkSlow( IsAllocated( Index ) );
+                return *reinterpret_cast<ElementType *>(
+                    &GetData( Index ).ElementData );
+        }
+        FORCEINLINE const ElementType &operator[]( int32 Index ) const {
+                checkSlow( IsAllocated( Index ) );
+                return *reinterpret_cast<const ElementType *>(
+                    &GetData( Index ).ElementData );
+        }
+
+        template <typename ArrayType, typename ValueType> class TBaseIterator {
+              public:
+                TBaseIterator( ArrayType &InArray, int32 StartIndex = 0 )
+                    : Array( InArray ),
+                      BitIterator( InArray.AllocationFlags, StartIndex ) {}
+
+                FORCEINLINE TBaseIterator &operator++() {
+                        ++BitIterator;
+                        return *this;
+                }
+
+                FORCEINLINE ValueType &operator*() const {
+                        return Array[BitIterator.GetIndex()];
+                }
+                FORCEINLINE ValueType *operator->() const {
+                        return &Array[BitIterator.GetIndex()];
+                }
+
+                FORCEINLINE explicit operator bool() const {
+                        return bool( BitIterator );
+                }
+
+                FORCEINLINE int32 GetIndex() const {
+                        return BitIterator.GetIndex();
+                }
+
+                /*Only the position matters, every end iterator compares equal*/
+                FORCEINLINE friend bool operator!=( const TBaseIterator &Lhs,
+                                                    const TBaseIterator &Rhs ) {
+                        return Lhs.GetIndex() != Rhs.GetIndex();
+                }
+
+              private:
+                ArrayType &Array;
+                TConstSetBitIterator BitIterator;
+        };
+
+        typedef TBaseIterator<TSparseArray, ElementType> TIterator;
+        typedef TBaseIterator<const TSparseArray, const ElementType>
+            TConstIterator;
+
+        FORCEINLINE TIterator begin() { return TIterator( *this ); }
+        FORCEINLINE TConstIterator begin() const {
+                return TConstIterator( *this );
+        }
+        FORCEINLINE TIterator end() {
+                return TIterator( *this, AllocationFlags.Num() );
+        }
+        FORCEINLINE TConstIterator end() const {
+                return TConstIterator( *this, AllocationFlags.Num() );
+        }
+
       private:
         typedef TArray<FElementOrFreeListLink> DataType;
         DataType Data;
@@ -876,16 +1323,76 @@ template <typename InElementType> class TSparseArray {
         int32 NumFreeIndices;
 };
 
+/**
+ * Engine compatible key hashes, TSet and TMap pick these up through an
+ * unqualified GetTypeHash call so engine types can overload it next to their
+ * declaration. They have to match what the engine hashed with or a lookup
+ * lands in the wrong bucket; keys hashed some other way go through FindByHash.
+ */
+FORCEINLINE uint32 HashCombine( uint32 A, uint32 C ) {
+        uint32 B = 0x9e3779b9;
+        A += B;
+
+        A -= B; A -= C; A ^= ( C >> 13 );
+        B -= C; B -= A; B ^= ( A << 8 );
+        C -= A; C -= B; C ^= ( B >> 13 );
+        A -= B; A -= C; A ^= ( C >> 12 );
+        B -= C; B -= A; B ^= ( A << 16 );
+        C -= A; C -= B; C ^= ( B >> 5 );
+        A -= B; A -= C; A ^= ( C >> 3 );
+        B -= C; B -= A; B ^= ( A << 10 );
+        C -= A; C -= B; C ^= ( B >> 15 );
+
+        return C;
+}
+
+template <typename T>
+FORCEINLINE std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, uint32>
+GetTypeHash( T Value ) {
+        if constexpr ( sizeof( T ) <= sizeof( uint32 ) ) {
+                return uint32( Value );
+        } else {
+                const uint64 Wide = uint64( Value );
+                return uint32( Wide ) + uint32( Wide >> 32 ) * 23;
+        }
+}
+
+FORCEINLINE uint32 GetTypeHash( float Value ) {
+        return std::bit_cast<uint32>( Value );
+}
+
+FORCEINLINE uint32 GetTypeHash( double Value ) {
+        return GetTypeHash( std::bit_cast<uint64>( Value ) );
+}
+
+/** PointerHash, the low 4 bits are dropped since allocations are 16 byte aligned. */
+FORCEINLINE uint32 GetTypeHash( const void *Value ) {
+        return HashCombine(
+            GetTypeHash( uint64( reinterpret_cast<uintptr_t>( Value ) >> 4 ) ),
+            0 );
+}
+
 template <typename InElementType> class TSetElement {
       private:
         template <typename SetDataType> friend class TSet;
 
+      public:
+        FORCEINLINE InElementType &GetValue() { return Value; }
+        FORCEINLINE const InElementType &GetValue() const { return Value; }
+
       private:
         InElementType Value;
         int32 HashNextId;
         int32 HashIndex;
 };
 
+/**
+ * Read side of the engine's TSet.
+ * Elements live in a TSparseArray, Hash is HashSize buckets (always a power
+ * of two) each holding the index of the first element in that bucket, and
+ * elements in the same bucket are chained through HashNextId. Lookups follow
+ * that chain the same way the engine does instead of scanning every element.
+ */
 template <typename InElementType> class TSet {
       public:
         typedef InElementType ElementType;
@@ -897,16 +1404,120 @@ template <typename InElementType> class TSet {
         /** Initialization constructor. */
         FORCEINLINE TSet() : HashSize( 0 ) {}
 
+        FORCEINLINE int32 Num() const { return Elements.Num(); }
+        FORCEINLINE bool IsEmpty() const { return Num() == 0; }
+
+        /**
+         * Index of the first element in KeyHash's bucket for which Matches
+         * returns true, INDEX_NONE if there is none.
+         */
+        template <typename PredicateType>
+        int32 FindIdByHash( uint32 KeyHash, PredicateType &&Matches ) const {
+                if ( HashSize <= 0 || Elements.Num() == 0 )
+                        return INDEX_NONE;
+
+                const int32 *Buckets = Hash.GetAllocation();
+                for ( int32 Id = Buckets[KeyHash & uint32( HashSize - 1 )];
+                      Id != INDEX_NONE; ) {
+                        /*A torn read of a map the game thread is rehashing shouldn't walk us off the array*/
+                        if ( !Elements.IsAllocated( Id ) )
+                                return INDEX_NONE;
+
+                        const SetElementType &Element = Elements[Id];
+                        if ( Matches( Element.Value ) )
+                                return Id;
+                        Id = Element.HashNextId;
+                }
+                return INDEX_NONE;
+        }
+
+        FORCEINLINE ElementType *FindByHash( uint32 KeyHash,
+                                             const ElementType &Key ) {
+                const int32 Id = FindIdByHash(
+                    KeyHash,
+                    [&]( const ElementType &Value ) { return Value == Key; } );
+                return Id != INDEX_NONE ? &Elements[Id].Value : nullptr;
+        }
+
+        FORCEINLINE ElementType *Find( const ElementType &Key ) {
+                return FindByHash( GetTypeHash( Key ), Key );
+        }
+        FORCEINLINE const ElementType *Find( const ElementType &Key ) const {
+                return const_cast<TSet *>( this )->Find( Key );
+        }
+
+        FORCEINLINE bool Contains( const ElementType &Key ) const {
+                return Find( Key ) != nullptr;
+        }
+
+        /** Element by the index FindIdByHash returned. */
+        FORCEINLINE ElementType &Get( int32 Id ) {
+                return Elements[Id].Value;
+        }
+        FORCEINLINE const ElementType &Get( int32 Id ) const {
+                return Elements[Id].Value;
+        }
+
+        template <typename ElementIteratorType, typename ValueType>
+        class TBaseIterator {
+              public:
+                explicit TBaseIterator( const ElementIteratorType &InIterator )
+                    : ElementIterator( InIterator ) {}
+
+                FORCEINLINE TBaseIterator &operator++() {
+                        ++ElementIterator;
+                        return *this;
+                }
+
+                FORCEINLINE ValueType &operator*() const {
+                        return ( *ElementIterator ).Value;
+                }
+                FORCEINLINE ValueType *operator->() const {
+                        return &( *ElementIterator ).Value;
+                }
+
+                FORCEINLINE explicit operator bool() const {
+                        return bool( ElementIterator );
+                }
+
+                FORCEINLINE int32 GetId() const {
+                        return ElementIterator.GetIndex();
+                }
+
+                FORCEINLINE friend bool operator!=( const TBaseIterator &Lhs,
+                                                    const TBaseIterator &Rhs ) {
+                        return Lhs.ElementIterator != Rhs.ElementIterator;
+                }
+
+              private:
+                ElementIteratorType ElementIterator;
+        };
+
       private:
         typedef TSparseArray<SetElementType> ElementArrayType;
         using HashType = TInlineAllocator<1>::ForElementType<int32>;
 
+      public:
+        typedef TBaseIterator<typename ElementArrayType::TIterator, ElementType>
+            TIterator;
+        typedef TBaseIterator<typename ElementArrayType::TConstIterator,
+                              const ElementType>
+            TConstIterator;
+
+        FORCEINLINE TIterator begin() { return TIterator( Elements.begin() ); }
+        FORCEINLINE TConstIterator begin() const {
+                return TConstIterator( Elements.begin() );
+        }
+        FORCEINLINE TIterator end() { return TIterator( Elements.end() ); }
+        FORCEINLINE TConstIterator end() const {
+                return TConstIterator( Elements.end() );
+        }
+
+      private:
         ElementArrayType Elements;
 
         mutable HashType Hash;
         mutable int32 HashSize;
-
-      public:
 };
 
 template <typename KeyType, typename ValueType> class TMapBase {
@@ -930,11 +1541,18 @@ template <typename KeyType, typename ValueType> class TMapBase {
         ElementSetType Pairs;
 };
 
+/**
+ * Read side of the engine's TMap, a TSet of key/value pairs hashed on the
+ * key only. Range-for yields each TPair, Find goes through the hash buckets.
+ */
 template <typename InKeyType, typename InValueType>
 class TMap : TMapBase<InKeyType, InValueType> {
+        typedef TMapBase<InKeyType, InValueType> Super;
+
       public:
         typedef InKeyType KeyType;
         typedef InValueType ValueType;
+        typedef typename Super::ElementType ElementType;
 
         TMap() = default;
         TMap( TMap && ) = default;
@@ -943,6 +1561,39 @@ class TMap : TMapBase<InKeyType, InValueType> {
         TMap &operator=( const TMap & ) = default;
 
       public:
+        FORCEINLINE int32 Num() const { return this->Pairs.Num(); }
+        FORCEINLINE bool IsEmpty() const { return this->Pairs.IsEmpty(); }
+
+        /** For keys the engine hashed with something other than GetTypeHash. */
+        FORCEINLINE ValueType *FindByHash( uint32 KeyHash, const KeyType &Key ) {
+                const int32 Id = this->Pairs.FindIdByHash(
+                    KeyHash,
+                    [&]( const ElementType &Pair ) { return Pair.Key == Key; } );
+                return Id != INDEX_NONE ? &this->Pairs.Get( Id ).Value : nullptr;
+        }
+
+        FORCEINLINE ValueType *Find( const KeyType &Key ) {
+                return FindByHash( GetTypeHash( Key ), Key );
+        }
+        FORCEINLINE const ValueType *Find( const KeyType &Key ) const {
+                return const_cast<TMap *>( this )->Find( Key );
+        }
+
+        FORCEINLINE bool Contains( const KeyType &Key ) const {
+                return Find( Key ) != nullptr;
+        }
+
+        /** Value for Key, or Default when it isn't in the map. */
+        FORCEINLINE ValueType FindRef( const KeyType &Key,
+                                       const ValueType &Default = {} ) const {
+                const ValueType *Value = Find( Key );
+                return Value ? *Value : Default;
+        }
+
+        FORCEINLINE auto begin() { return this->Pairs.begin(); }
+        FORCEINLINE auto begin() const { return this->Pairs.begin(); }
+        FORCEINLINE auto end() { return this->Pairs.end(); }
+        FORCEINLINE auto end() const { return this->Pairs.end(); }
 };
 
 #define UE_PTRDIFF_TO_INT32( argument ) static_cast<int32>( argument )
@@ -979,6 +1630,9 @@ static std::vector<std::string> SplitString( const std::string &input,
         return parts;
 }
 
+/** Non-owning view of an FString's characters. */
+using FStringView = std::wstring_view;
+
 class FString {
 
       private:
@@ -989,50 +1643,147 @@ class FString {
         using ElementType = wchar_t;
 
         FString() = default;
-        FString( FString && ) = default;
-        FString( const FString & ) = default;
-        FString &operator=( FString && ) = default;
-        FString &operator=( const FString & ) = default;
+
+        /** Copies are deep, each FString owns its own engine allocation. */
+        FString( const FString &Other ) { Assign( Other.View() ); }
+
+        FString( FString &&Other ) noexcept = default;
+
+        FString &operator=( const FString &Other ) {
+                if ( this != &Other )
+                        Assign( Other.View() );
+                return *this;
+        }
+
+        FString &operator=( FString &&Other ) noexcept {
+                if ( this != &Other ) {
+                        FreeAllocation();
+                        Data = std::move( Other.Data );
+                }
+                return *this;
+        }
+
+        ~FString() { FreeAllocation(); }
 
       public:
+        /**
+         * The characters are copied into memory from FMemory, so the string
+         * can be handed to the engine as a parameter and the engine is free to
+         * resize or free it like one of its own.
+         */
         FString( const wchar_t *Str ) {
-                const uint32 NullTerminatedLength =
-                    static_cast<uint32>( wcslen( Str ) + 0x1 );
+                if ( Str )
+                        Assign( FStringView( Str ) );
+        }
+
+        FString( FStringView Str ) { Assign( Str ); }
+
+        FString( const std::wstring &Str ) { Assign( Str ); }
 
-                Data.Data = ( const_cast<wchar_t *>( Str ) );
-                Data.ArrayNum = NullTerminatedLength;
-                Data.ArrayMax = NullTerminatedLength;
+        /*Each byte is widened on its own, same as before*/
+        FString( const std::string &Str ) {
+                const int32 Length = int32( Str.size() );
+                if ( Length == 0 )
+                        return;
+
+                wchar_t *NewData = Allocate( Length + 1 );
+                if ( !NewData )
+                        return;
+
+                Data.Data = NewData;
+                Data.ArrayMax = Length + 1;
+                for ( int32 i = 0; i < Length; i++ )
+                        Data.Data[i] = wchar_t( uint8( Str[i] ) );
+                Data.Data[Length] = L'\0';
+                Data.ArrayNum = Length + 1;
         }
 
-        FString( const std::string &Str )
-            : FString( std::wstring( Str.begin(), Str.end() ).c_str() ) {}
+        /** Replaces the contents, reusing the allocation when it's big enough. */
+        void Assign( FStringView Str ) {
+                const int32 Length = int32( Str.size() );
+                if ( Length == 0 ) {
+                        Data.ArrayNum = 0;
+                        return;
+                }
 
-        FString( const std::wstring &Str ) : FString( Str.c_str() ) {}
+                if ( Length + 1 <= Data.ArrayMax ) {
+                        /*Str may point into our own buffer*/
+                        memmove( Data.Data, Str.data(), Str.size() * sizeof( wchar_t ) );
+                } else {
+                        wchar_t *NewData = Allocate( Length + 1 );
+                        if ( !NewData ) {
+                                Data.ArrayNum = 0;
+                                return;
+                        }
+                        memcpy( NewData, Str.data(), Str.size() * sizeof( wchar_t ) );
+                        FreeAllocation();
+                        Data.Data = NewData;
+                        Data.ArrayMax = Length + 1;
+                }
+                Data.Data[Length] = L'\0';
+                Data.ArrayNum = Length + 1;
+        }
 
-      public:
-        std::string ToString() {
-                wchar_t *ProcessedData = Data.GetData();
-                std::wstring WideDataString( ProcessedData );
+        /** Frees the allocation and leaves the string empty. */
+        void Empty() {
+                FreeAllocation();
+                Forget();
+        }
 
-                return std::string( WideDataString.begin(),
-                                    WideDataString.end() );
+      private:
+        template <int32 NumInlineChars> friend class TInlineString;
+
+        /*Points at a terminated buffer this string doesn't own, see TInlineString*/
+        FORCEINLINE void Borrow( wchar_t *Buffer, int32 Length ) {
+                Data.Data = Buffer;
+                Data.ArrayNum = Length + 1;
+                Data.ArrayMax = Length + 1;
         }
 
-        std::string ToString() const {
-                const wchar_t *ProcessedData = Data.GetData();
-                std::wstring WideDataString( ProcessedData );
+        FORCEINLINE void Forget() {
+                Data.Data = nullptr;
+                Data.ArrayNum = 0;
+                Data.ArrayMax = 0;
+        }
 
-                return std::string( WideDataString.begin(),
-                                    WideDataString.end() );
+        /*Null before Init or if GMalloc wasn't found, the string is left empty then*/
+        static wchar_t *Allocate( int32 NumChars ) {
+                return (wchar_t *)FMemory::Malloc(
+                    uint64( NumChars ) * sizeof( wchar_t ), alignof( wchar_t ) );
         }
 
-        std::wstring ToWideString() {
-                wchar_t *ProcessedData = Data.GetData();
-                std::wstring WideDataString( ProcessedData );
+        void FreeAllocation() {
+                /*Free leaks instead if FName::ToString ran before FMemory was found*/
+                FMemory::Free( Data.Data );
+        }
 
-                return WideDataString;
+      public:
+        /** Length without the terminator. */
+        FORCEINLINE int32 Len() const {
+                return Data.Num() > 0 ? Data.Num() - 1 : 0;
+        }
+
+        FORCEINLINE bool IsEmpty() const { return Len() == 0; }
+
+        /** Borrows the characters, valid for as long as the string isn't changed or freed. */
+        FORCEINLINE FStringView View() const {
+                return Data.GetData() ? FStringView( Data.GetData(), size_t( Len() ) )
+                                      : FStringView();
+        }
+
+        /** Appends the UTF-8 form of this string to Out, no temporaries. */
+        FORCEINLINE void AppendString( std::string &Out ) const {
+                AppendUtf8( View(), Out );
+        }
+
+        std::string ToString() const {
+                std::string Result;
+                AppendString( Result );
+                return Result;
         }
 
+        std::wstring ToWideString() const { return std::wstring( View() ); }
+
         FORCEINLINE const TCHAR *operator*() const {
                 const wchar_t *t = L"";
                 return Data.Num() ? Data.GetData() : t;
@@ -1097,22 +1848,78 @@ class FString {
 
         void ParseIntoArray( std::vector<std::string> &OutArray,
                              FString &Delimiter, bool bCullEmpty = true ) {
-                size_t Start = 0;
-                size_t End;
-                std::string Source = this->ToString();
-                std::string Delim = Delimiter.ToString();
+                /*Only the parts outlive the split, the rest stays on the thread's FMemStack*/
+                FMemStackScope Scope;
+                std::pmr::string Source( Scope.GetResource() );
+                std::pmr::string Delim( Scope.GetResource() );
+                AppendUtf8( View(), Source );
+                AppendUtf8( Delimiter.View(), Delim );
 
                 UE_LOG( LogFortSDK, VeryVerbose, "Source: %s, Delim : %s",
                         Source.c_str(), Delim.c_str() );
 
-                auto Dih = SplitString( Source, Delim.c_str() );
+                /*Same split as SplitString( Source, Delim, 3 ), over views*/
+                const std::string_view SourceView( Source );
+                std::string_view Parts[3];
+                size_t NumParts = 0;
+                size_t Start = 0;
+                size_t Pos;
+                while ( NumParts < 2 && ( Pos = SourceView.find( Delim, Start ) ) !=
+                                            std::string_view::npos ) {
+                        Parts[NumParts++] = SourceView.substr( Start, Pos - Start );
+                        Start = Pos + Delim.size();
+                }
+                Parts[NumParts++] = SourceView.substr( Start );
 
-                if ( Dih.size() == 3 ) {
-                        for ( std::string Str : Dih ) {
-                                OutArray.push_back( Str );
+                if ( NumParts == 3 ) {
+                        for ( std::string_view Part : Parts ) {
+                                OutArray.emplace_back( Part );
                         }
                 }
         }
 };
 
+/**
+ * FString for read only parameters that keeps short strings inline.
+ * Up to NumInlineChars characters the FString just points at the buffer
+ * inside this object, so passing a name by const reference costs no
+ * allocation. Longer strings get a normal FMemory allocation. The engine must
+ * not resize or keep the inline version, so never pass it as an out param.
+ *
+ * static TFunctionCaller<void( const FString & )> SetName( ... );
+ * SetName( Object, TInlineString<>( L"Jonesy" ) );
+ */
+template <int32 NumInlineChars = 64> class TInlineString {
+      public:
+        TInlineString( FStringView Str ) {
+                const int32 Length = int32( Str.size() );
+                if ( Length >= NumInlineChars ) {
+                        String.Assign( Str );
+                        return;
+                }
+
+                memcpy( Buffer, Str.data(), Str.size() * sizeof( wchar_t ) );
+                Buffer[Length] = L'\0';
+                String.Borrow( Buffer, Length );
+        }
+
+        TInlineString( const wchar_t *Str ) : TInlineString( FStringView( Str ) ) {}
+
+        ~TInlineString() {
+                /*The buffer isn't FMemory's, keep ~FString away from it*/
+                if ( String.Data.GetData() == Buffer )
+                        String.Forget();
+        }
+
+        TInlineString( const TInlineString & ) = delete;
+        TInlineString &operator=( const TInlineString & ) = delete;
+
+        FORCEINLINE const FString &Get() const { return String; }
+        FORCEINLINE operator const FString &() const { return String; }
+
+      private:
+        FString String;
+        wchar_t Buffer[NumInlineChars];
+};
+
 }; // namespace SDK
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+namespace SDK
+{
+/**
+ * Element types TArray can search by comparing raw bytes, which is what lets
+ * Find and Contains use the SIMD kernels below. Integers, enums and pointers
+ * qualify on their own; a struct whose operator== is a plain compare of every
+ * byte can opt in by specializing this.
+ */
+template <typename T>
+constexpr bool TIsBitwiseComparable =
+    std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+namespace ArraySearch
+{
+/*Below this the setup of a vector loop costs more than it saves*/
+constexpr int32_t MinVectorNum = 16;
+
+/**
+ * Index of the first/last element equal to Value, INDEX_NONE if there is none.
+ * AVX2 or SSE2 is picked once from cpuid on first use.
+ */
+int32_t FindFirst32( const uint32_t *Data, int32_t Num, uint32_t Value );
+int32_t FindLast32( const uint32_t *Data, int32_t Num, uint32_t Value );
+int32_t FindFirst64( const uint64_t *Data, int32_t Num, uint64_t Value );
+int32_t FindLast64( const uint64_t *Data, int32_t Num, uint64_t Value );
+
+/*Whether the kernels above run the AVX2 versions on this CPU*/
+bool UsesAVX2();
+
+template <typename T>
+FORCEINLINE int32_t FindFirst( const T *Data, int32_t Num, const T &Value ) {
+        static_assert( sizeof( T ) == 4 || sizeof( T ) == 8 );
+        if ( Num < MinVectorNum ) {
+                for ( int32_t i = 0; i < Num; i++ ) {
+                        if ( std::memcmp( &Data[i], &Value, sizeof( T ) ) == 0 )
+                                return i;
+                }
+                return -1;
+        }
+
+        if constexpr ( sizeof( T ) == 4 )
+                return FindFirst32( reinterpret_cast<const uint32_t *>( Data ), Num,
+                                    std::bit_cast<uint32_t>( Value ) );
+        else
+                return FindFirst64( reinterpret_cast<const uint64_t *>( Data ), Num,
+                                    std::bit_cast<uint64_t>( Value ) );
+}
+
+template <typename T>
+FORCEINLINE int32_t FindLast( const T *Data, int32_t Num, const T &Value ) {
+        static_assert( sizeof( T ) == 4 || sizeof( T ) == 8 );
+        if ( Num < MinVectorNum ) {
+                for ( int32_t i = Num - 1; i >= 0; i-- ) {
+                        if ( std::memcmp( &Data[i], &Value, sizeof( T ) ) == 0 )
+                                return i;
+                }
+                return -1;
+        }
+
+        if constexpr ( sizeof( T ) == 4 )
+                return FindLast32( reinterpret_cast<const uint32_t *>( Data ), Num,
+                                   std::bit_cast<uint32_t>( Value ) );
+        else
+                return FindLast64( reinterpret_cast<const uint64_t *>( Data ), Num,
+                                   std::bit_cast<uint64_t>( Value ) );
+}
+}
+}
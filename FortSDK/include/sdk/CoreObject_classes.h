@@ -126,6 +126,14 @@ enum EObjectFlags {
                         ///< UObjects
 };
 
+/** How FName's string constructor treats a name the engine hasn't seen yet. */
+enum EFindName {
+        /*Returns None instead of adding it*/
+        FNAME_Find,
+        /*Adds it to the name table*/
+        FNAME_Add,
+};
+
 class FName
 {
       private:
@@ -133,6 +141,21 @@ class FName
         uint32 Number;
 
       public:
+        FName() = default;
+
+        /**
+         * Goes through the engine's FName constructor, so "Name_3" comes out
+         * with Number 4 like it does in the engine. Resolved names are interned
+         * in a process wide cache, building the same name again is one hash
+         * lookup. None if the constructor couldn't be found.
+         */
+        explicit FName( std::wstring_view Name, EFindName FindType = FNAME_Add );
+        explicit FName( const wchar_t *Name, EFindName FindType = FNAME_Add )
+            : FName( std::wstring_view( Name ? Name : L"" ), FindType ) {}
+        /*ASCII only, each byte becomes one character*/
+        explicit FName( std::string_view Name, EFindName FindType = FNAME_Add );
+
+        FORCEINLINE bool IsNone() const { return ComparisonIndex == 0 && Number == 0; }
 
         FORCEINLINE int32 GetNumber() const { return Number; }
 
@@ -145,8 +168,26 @@ class FName
         }
 
         FString ToString() const;
+        /*Appends the name as UTF-8, lets a caller reuse one buffer for every name*/
+        void AppendString( std::string &Out ) const;
+
+        FORCEINLINE bool operator==( const FName &Other ) const {
+                return ComparisonIndex == Other.ComparisonIndex &&
+                       Number == Other.Number;
+        }
+        FORCEINLINE bool operator!=( const FName &Other ) const {
+                return !( *this == Other );
+        }
+
+        /*Same hash the engine's name keyed maps are built with*/
+        friend FORCEINLINE uint32 GetTypeHash( const FName &Name ) {
+                return uint32( Name.ComparisonIndex ) + Name.Number;
+        }
 };
 
+/*operator== compares both members and there's no padding, so TArray<FName> can use the SIMD search*/
+template <> constexpr bool TIsBitwiseComparable<FName> = true;
+
 /** Mask for all object flags */
 #define RF_AllFlags                                                            \
         (EObjectFlags)0xffffffff ///< All flags, used mainly for error checking
@@ -503,6 +544,16 @@ class UObject : public UObjectBaseUtility {
       public:
         void ProcessEvent( class UFunction *Function, void *Parms ) const;
 
+        /**
+         * ProcessEvent with FUNC_Native forced on for the duration of the call, the
+         * way CallFunc has always invoked functions. The one place that flips the
+         * flag: callers of the same function share the count kept in its
+         * FFunctionParamsInfo, and it's cleared again when the last one returns.
+         * Functions that were native when Info was built go straight through.
+         */
+        void ProcessEventAsNative( class UFunction *Function, void *Parms,
+                                   const struct FFunctionParamsInfo *Info ) const;
+
         /*Theres no checks on this so make sure you check the offset is not equal to 0 or you are positive that this is going to be found*/
         template <typename T>
         T& Get( const std::string &ClassName, const std::string &PropName );
@@ -515,6 +566,14 @@ class UObject : public UObjectBaseUtility {
                       const std::string &FunctionName, Args &&...args );
 
         class UFunction *GetFunction(const std::string& FunctionName);
+
+        /**
+         * Calls a native function's exec thunk directly instead of going through
+         * ProcessEvent. Only valid when Function->CanInvokeNative() is true.
+         */
+        void InvokeNative( class UFunction *Function, void *Parms ) const;
+        void InvokeNative( class UFunction *Function, void *Parms,
+                           const struct FFunctionParamsInfo *ParamsInfo ) const;
 };
 
 class UField : public UObject
@@ -578,14 +637,34 @@ class FProperty500 : public FField
         int32 Offset;
         FName RepNotifyFunc;
         FProperty500 *PropertyLinkNext;
+        FProperty500 *NextRef;
+        FProperty500 *DestructorLinkNext;
+
+        /*ArrayDim, ElementSize and PropertyFlags sit right before Offset_Internal, same as FProperty*/
+        static constexpr int32 OffsetInternalOffset = 0x44;
 
         int32 Offset_Internal() {
-                return *reinterpret_cast<int32 *>( __int64( this ) + 0x44 );
+                return *reinterpret_cast<int32 *>( __int64( this ) +
+                                                   OffsetInternalOffset );
+        }
+
+        int32 ArrayDim() {
+                return *reinterpret_cast<int32 *>( __int64( this ) +
+                                                   OffsetInternalOffset - 0x14 );
+        }
+
+        int32 ElementSize() {
+                return *reinterpret_cast<int32 *>( __int64( this ) +
+                                                   OffsetInternalOffset - 0x10 );
+        }
+
+        EPropertyFlags PropertyFlags() {
+                return GetPropertyFlags();
         }
 
         EPropertyFlags& GetPropertyFlags() {
                 return *reinterpret_cast<EPropertyFlags *>(
-                    __int64( this ) + offsetof( FProperty,PropertyFlags ) );
+                    __int64( this ) + OffsetInternalOffset - 0xC );
         }
 };
 
@@ -660,6 +739,12 @@ class UStruct : public UField
                         *OutPropertyLink =
                             reinterpret_cast<T *>( PropertyLink() );
         }
+        template <typename T>
+        void GetDestructorLink( T **OutDestructorLink ) {
+                if ( OutDestructorLink )
+                        *OutDestructorLink =
+                            reinterpret_cast<T *>( DestructorLink() );
+        }
         UStruct *GetSuperStruct() const { return SuperStruct(); }
         FField *GetChildrenProperties() const { return ChildrenProperties(); }
         UField *GetChildren() const { return Children(); }
@@ -693,6 +778,42 @@ class UClass : public UStruct
 typedef void ( *FNativeFuncPtr )( UObject *Context, void *TheStack,
                                   RESULT_DECL );
 
+/**
+ * Function flags.
+ */
+enum EFunctionFlags : uint32 {
+        FUNC_None = 0x00000000,
+        FUNC_Final = 0x00000001, ///< Function is final (prebindable, non-overridable function).
+        FUNC_BlueprintAuthorityOnly = 0x00000004, ///< Function will only run if the object has network authority
+        FUNC_BlueprintCosmetic = 0x00000008, ///< Function is cosmetic in nature and should not be invoked on dedicated servers
+        FUNC_Net = 0x00000040, ///< Function is network-replicated.
+        FUNC_NetReliable = 0x00000080, ///< Function should be sent reliably on the network.
+        FUNC_NetRequest = 0x00000100, ///< Function is sent to a net service
+        FUNC_Exec = 0x00000200, ///< Executable from command line.
+        FUNC_Native = 0x00000400, ///< Native function.
+        FUNC_Event = 0x00000800, ///< Event function.
+        FUNC_NetResponse = 0x00001000, ///< Function response from a net service
+        FUNC_Static = 0x00002000, ///< Static function.
+        FUNC_NetMulticast = 0x00004000, ///< Function is networked multicast Server -> All Clients
+        FUNC_UbergraphFunction = 0x00008000, ///< Function is used as the merge 'ubergraph' for a blueprint
+        FUNC_MulticastDelegate = 0x00010000, ///< Function is a multi-cast delegate signature
+        FUNC_Public = 0x00020000, ///< Function is accessible in all classes
+        FUNC_Private = 0x00040000, ///< Function is accessible only in the class it is defined in
+        FUNC_Protected = 0x00080000, ///< Function is accessible only in the class it is defined in and subclasses
+        FUNC_Delegate = 0x00100000, ///< Function is delegate signature
+        FUNC_NetServer = 0x00200000, ///< Function is executed on servers
+        FUNC_HasOutParms = 0x00400000, ///< function has out (pass by reference) parameters
+        FUNC_HasDefaults = 0x00800000, ///< function has structs that contain defaults
+        FUNC_NetClient = 0x01000000, ///< function is executed on clients
+        FUNC_DLLImport = 0x02000000, ///< function is imported from a DLL
+        FUNC_BlueprintCallable = 0x04000000, ///< function can be called from blueprint code
+        FUNC_BlueprintEvent = 0x08000000, ///< function can be overridden/implemented from a blueprint
+        FUNC_BlueprintPure = 0x10000000, ///< function can be called from blueprint code, and is also pure
+        FUNC_EditorOnly = 0x20000000, ///< function can only be called from an editor script
+        FUNC_Const = 0x40000000, ///< function can be called from blueprint code, and only reads state
+        FUNC_NetValidate = 0x80000000, ///< function must supply a _Validate implementation
+};
+
 class UFunction : public UStruct
 {
       private:
@@ -707,6 +828,23 @@ class UFunction : public UStruct
                 return *reinterpret_cast<uint32 *>( __int64( this ) +
                                                     FunctionFlagsOffset );
         }
+        FORCEINLINE bool HasAnyFunctionFlags( uint32 FlagsToCheck ) {
+                return ( FunctionFlags() & FlagsToCheck ) != 0;
+        }
+
+        /*Size of the parms frame as the engine laid it out, trailing padding included. FunctionFlags, NumParms, then this*/
+        inline uint16_t& ParmsSize() {
+                return *reinterpret_cast<uint16_t *>(
+                    __int64( &FunctionFlags() ) + 0x6 );
+        }
+
+        /**
+         * True if the exec thunk can be called without ProcessEvent in between.
+         * That rules out anything ProcessEvent would reroute: RPCs, functions a
+         * blueprint can override, and interface functions which need the
+         * object pointer adjusted.
+         */
+        bool CanInvokeNative();
 
       public:
         static UClass *StaticClass() {
@@ -1169,7 +1307,12 @@ class FUObjectArray {
                 return 0;
         }
 
-        FORCEINLINE UObject *FindObject( std::string Name ) const {
+        FORCEINLINE UObject *FindObject( std::string_view Name ) const {
+                /*One scratch string reused for every object instead of a new one each*/
+                FMemStackScope Scope;
+                std::pmr::string ObjectName( Scope.GetResource() );
+                ObjectName.reserve( 256 );
+
                 for ( int i = 0; i < this->GetObjectArrayNum(); i++ ) {
                         FUObjectItem* ObjectItem = this->IndexToObject(i);
                         if ( !ObjectItem )
@@ -1177,7 +1320,9 @@ class FUObjectArray {
                         UObjectBase *Object = ObjectItem->Object;
                         if ( !Object )
                                 continue;
-                        if ( Object->GetFName().ToString().ToString() == Name )
+                        ObjectName.clear();
+                        AppendUtf8( Object->GetFName().ToString().View(), ObjectName );
+                        if ( ObjectName == Name )
                                 return (UObject*)Object;
                 }
                 return nullptr;
@@ -1303,6 +1448,16 @@ class FUObjectArray {
                 return ObjectItem->GetSerialNumber();
         }
 
+        /**
+         * Returns the serial number for the UObject at Index, having the
+         * engine allocate one first if it has none yet, like FWeakObjectPtr
+         * does. Returns 0 if the engine's allocator wasn't found: such an
+         * object can't be told apart from the next one to reuse its slot.
+         * @param Index - UObject Index
+         * @return - the serial number for this UObject, 0 if it has none
+         */
+        int32 AllocateSerialNumber( int32 Index );
+
         FORCEINLINE FUObjectItem *
         ObjectToObjectItem( const UObjectBase *Object ) {
                 FUObjectItem *ObjectItem =
@@ -0,0 +1,268 @@
+#pragma once
+
+namespace SDK
+{
+template <typename Signature> class TFunctionCaller;
+
+/**
+ * A UFunction resolved once into a typed call.
+ * Bind looks the function up, checks every argument against the reflected
+ * parameter size and keeps the offsets, so a call is just the stores into the
+ * frame and one ProcessEvent. Non-const reference arguments are copied back
+ * after the call, which is how out params are read. CallOnGameThread and
+ * Post queue the same call on DispatchLibrary instead of running it.
+ * UseNativeInvoke skips ProcessEvent and calls the exec thunk directly, for
+ * native functions that allow it.
+ *
+ * static TFunctionCaller<bool( int32 )> SetHealth( "FortPawn", "SetHealth" );
+ * SetHealth( Pawn, 100 );
+ */
+template <typename Ret, typename... Args> class TFunctionCaller<Ret( Args... )>
+{
+      public:
+        static constexpr size_t NumArgs = sizeof...( Args );
+
+        TFunctionCaller() = default;
+
+        TFunctionCaller( const std::string &ClassName,
+                         const std::string &FunctionName ) {
+                Bind( ClassName, FunctionName );
+        }
+
+        bool Bind( const std::string &ClassName,
+                   const std::string &FunctionName ) {
+                UFunction *Func =
+                    PropLibrary->GetFunctionByName( ClassName, FunctionName )
+                        .Func;
+                if ( !Func ) {
+                        UE_LOG( LogFortSDK, Warning,
+                                "TFunctionCaller failed to find %s::%s",
+                                ClassName.c_str(), FunctionName.c_str() );
+                        return false;
+                }
+
+                return Bind( Func );
+        }
+
+        bool Bind( UFunction *Func ) {
+                Function = nullptr;
+                ParamsInfo = nullptr;
+                bNativeInvoke = false;
+                bForceNativeFlag = false;
+
+                if ( !Func )
+                        return false;
+
+                const FFunctionParamsInfo *Info =
+                    PropLibrary->GetFunctionParamsInfo( Func );
+                const std::string FunctionName =
+                    Func->GetFName().ToString().ToString();
+
+                if ( Info->Params.size() != NumArgs ) {
+                        UE_LOG( LogFortSDK, Warning,
+                                "TFunctionCaller bound %s with %zu arguments "
+                                "but it takes %zu",
+                                FunctionName.c_str(), NumArgs,
+                                Info->Params.size() );
+                        return false;
+                }
+
+                constexpr size_t ArgSizes[] = {
+                    sizeof( std::remove_cvref_t<Args> )..., 0 };
+                for ( size_t i = 0; i < NumArgs; i++ ) {
+                        if ( Info->Params[i].Size != int32( ArgSizes[i] ) ) {
+                                UE_LOG( LogFortSDK, Warning,
+                                        "TFunctionCaller argument %zu of %s is "
+                                        "%zu bytes, reflected size is %d",
+                                        i, FunctionName.c_str(), ArgSizes[i],
+                                        Info->Params[i].Size );
+                                return false;
+                        }
+                        ArgOffsets[i] = Info->Params[i].Offset;
+                }
+
+                if constexpr ( !std::is_void_v<Ret> ) {
+                        if ( Info->ReturnValue.Offset == -1 ||
+                             Info->ReturnValue.Size != int32( sizeof( Ret ) ) ) {
+                                UE_LOG( LogFortSDK, Warning,
+                                        "TFunctionCaller return type of %s is "
+                                        "%zu bytes, reflected size is %d",
+                                        FunctionName.c_str(), sizeof( Ret ),
+                                        Info->ReturnValue.Size );
+                                return false;
+                        }
+                        ReturnOffset = Info->ReturnValue.Offset;
+                }
+
+                ParamsInfo = Info;
+                Function = Func;
+                bForceNativeFlag = !Info->bWasNative;
+                return true;
+        }
+
+        FORCEINLINE bool IsBound() const { return Function != nullptr; }
+        FORCEINLINE bool UsesNativeInvoke() const { return bNativeInvoke; }
+
+        /*Switches operator() to UObject::InvokeNative, returns false if the bound function can't take it*/
+        bool UseNativeInvoke() {
+                bNativeInvoke = Function && Function->CanInvokeNative();
+                return bNativeInvoke;
+        }
+
+        FORCEINLINE UFunction *GetFunction() const { return Function; }
+
+        Ret operator()( UObject *Object, Args... InArgs ) const {
+                if ( !Function || !Object ) {
+                        if constexpr ( !std::is_void_v<Ret> )
+                                return Ret{};
+                        else
+                                return;
+                }
+
+                FFunctionParamsFrame Frame( ParamsInfo );
+                StoreArgs( Frame, std::index_sequence_for<Args...>{},
+                           InArgs... );
+
+                if ( bNativeInvoke ) {
+                        Object->InvokeNative( Function, Frame.GetData(),
+                                              ParamsInfo );
+                } else if ( bForceNativeFlag ) {
+                        Object->ProcessEventAsNative( Function, Frame.GetData(),
+                                                      ParamsInfo );
+                } else {
+                        Object->ProcessEvent( Function, Frame.GetData() );
+                }
+
+                LoadOutArgs( Frame, std::index_sequence_for<Args...>{},
+                             InArgs... );
+
+                if constexpr ( !std::is_void_v<Ret> ) {
+                        Frame.ReleaseReturnValue();
+                        return std::move( *reinterpret_cast<Ret *>(
+                            Frame.GetData() + ReturnOffset ) );
+                }
+        }
+
+        /**
+         * Queues the call on DispatchLibrary and returns right away, the future is
+         * fulfilled once the game thread drains the queue, with a default Ret if
+         * Object was destroyed in between or had no serial number to tell. Out params can't be written back from
+         * there, so every argument is taken by value.
+         */
+        std::future<Ret>
+        CallOnGameThread( UObject *Object,
+                          const std::remove_cvref_t<Args> &...InArgs ) const {
+                auto Promise = std::make_shared<std::promise<Ret>>();
+                std::future<Ret> Future = Promise->get_future();
+
+                FQueuedCall *Call = QueueArgs( Object, InArgs... );
+                if ( !Call ) {
+                        if constexpr ( !std::is_void_v<Ret> )
+                                Promise->set_value( Ret{} );
+                        else
+                                Promise->set_value();
+                        return Future;
+                }
+
+                Call->OnComplete = [Promise, ReturnOffset = ReturnOffset](
+                                       FQueuedCall &Completed ) {
+                        if constexpr ( !std::is_void_v<Ret> ) {
+                                if ( Completed.bFailed ) {
+                                        Promise->set_value( Ret{} );
+                                        return;
+                                }
+                                Completed.bOwnsReturnValue = false;
+                                Promise->set_value( std::move( *reinterpret_cast<Ret *>(
+                                    Completed.GetParams() + ReturnOffset ) ) );
+                        } else {
+                                Promise->set_value();
+                        }
+                };
+
+                DispatchLibrary->Submit( Call );
+                return Future;
+        }
+
+        /*Fire and forget version of CallOnGameThread*/
+        void Post( UObject *Object,
+                   const std::remove_cvref_t<Args> &...InArgs ) const {
+                DispatchLibrary->Submit( QueueArgs( Object, InArgs... ) );
+        }
+
+      private:
+        FQueuedCall *
+        QueueArgs( UObject *Object,
+                   const std::remove_cvref_t<Args> &...InArgs ) const {
+                if ( !Function || !Object )
+                        return nullptr;
+
+                FQueuedCall *Call =
+                    DispatchLibrary->AllocateCall( Object, Function );
+                uint8 *Data = Call->GetParams();
+                size_t Index = 0;
+                (
+                    [&] {
+                            ::new ( Data + ArgOffsets[Index] )
+                                std::remove_cvref_t<Args>( InArgs );
+                            /*The caller is gone by the time this runs, so the
+                             * call owns its deep copy of every FString*/
+                            if constexpr ( std::is_same_v<std::remove_cvref_t<Args>,
+                                                          FString> ) {
+                                    if ( Index < 64 )
+                                            Call->OwnedInputMask |= uint64_t( 1 )
+                                                                    << Index;
+                            }
+                            /*Only inputs stay the caller's, whatever the engine
+                             * writes into a pure out param has nobody to read it*/
+                            const FParamInfo &Param = ParamsInfo->Params[Index];
+                            if ( Index < 64 && ( !Param.IsOut() || Param.IsRef() ) )
+                                    Call->CallerOwnedMask |= uint64_t( 1 ) << Index;
+                            Index++;
+                    }(),
+                    ... );
+                return Call;
+        }
+
+        template <typename T>
+        static constexpr bool IsOutArg =
+            std::is_lvalue_reference_v<T> &&
+            !std::is_const_v<std::remove_reference_t<T>>;
+
+        template <size_t... Is>
+        FORCEINLINE void StoreArgs( FFunctionParamsFrame &Frame,
+                                    std::index_sequence<Is...>,
+                                    const std::remove_cvref_t<Args> &...InArgs ) const {
+                /*Borrowed bitwise like CallFunc does, an FString argument isn't
+                 * deep copied and stays the caller's*/
+                uint8 *Data = Frame.GetData();
+                ( std::memcpy( Data + ArgOffsets[Is], &InArgs,
+                               sizeof( std::remove_cvref_t<Args> ) ),
+                  ... );
+                ( Frame.MarkCallerOwned( Is ), ... );
+        }
+
+        template <size_t... Is>
+        FORCEINLINE void LoadOutArgs( FFunctionParamsFrame &Frame,
+                                      std::index_sequence<Is...>,
+                                      Args &...InArgs ) const {
+                /*Moved back bitwise as well, the engine may have freed or
+                 * grown the buffer the caller lent it*/
+                uint8 *Data = Frame.GetData();
+                (
+                    [&] {
+                            if constexpr ( IsOutArg<Args> )
+                                    std::memcpy( &InArgs, Data + ArgOffsets[Is],
+                                                 sizeof( std::remove_cvref_t<Args> ) );
+                    }(),
+                    ... );
+        }
+
+        UFunction *Function = nullptr;
+        const FFunctionParamsInfo *ParamsInfo = nullptr;
+        int32 ArgOffsets[NumArgs + 1] = {};
+        int32 ReturnOffset = -1;
+        bool bNativeInvoke = false;
+        /*Decided in Bind, only functions that aren't native already need FUNC_Native forced*/
+        bool bForceNativeFlag = false;
+};
+}
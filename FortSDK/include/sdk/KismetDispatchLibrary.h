@@ -0,0 +1,66 @@
+#pragma once
+namespace SDK
+{
+    /**
+     * One ProcessEvent waiting for the game thread.
+     * The parameter frame is allocated in the same block right after the call,
+     * so queuing a call is a single allocation.
+     */
+    struct alignas( 16 ) FQueuedCall
+    {
+            FQueuedCall *Next = nullptr;
+            UObject *Object = nullptr;
+            /*Object's slot in GUObjectArray when it was queued, a different serial means it's gone.
+             * Allocated when queuing, 0 only if the engine's allocator wasn't found and the call is dropped*/
+            int32_t ObjectIndex = -1;
+            int32_t ObjectSerialNumber = 0;
+            UFunction *Function = nullptr;
+            const FFunctionParamsInfo *ParamsInfo = nullptr;
+            uint64_t CallerOwnedMask = 0;
+            /*Params the call made its own copy of, freed after the call whatever their direction*/
+            uint64_t OwnedInputMask = 0;
+            bool bOwnsReturnValue = true;
+            /*Set by Drain when Object no longer existed, or couldn't be checked, and ProcessEvent was skipped*/
+            bool bFailed = false;
+            /*Runs on the game thread right after ProcessEvent, before the frame is released*/
+            std::function<void( FQueuedCall & )> OnComplete;
+
+            FORCEINLINE uint8_t *GetParams() {
+                    return reinterpret_cast<uint8_t *>( this ) +
+                           sizeof( FQueuedCall );
+            }
+    };
+
+    /**
+     * Multi producer, single consumer queue of ProcessEvent calls.
+     * Any thread can queue a call without taking a lock, the game thread runs the
+     * whole batch from one Drain, usually from a tick or ProcessEvent hook.
+     */
+	class FKismetDispatchLibrary
+	{
+          public:
+            FKismetDispatchLibrary() = default;
+            ~FKismetDispatchLibrary();
+
+            FKismetDispatchLibrary( const FKismetDispatchLibrary & ) = delete;
+            FKismetDispatchLibrary &
+            operator=( const FKismetDispatchLibrary & ) = delete;
+
+          private:
+            std::atomic<FQueuedCall *> Head{ nullptr };
+            std::atomic<int32_t> NumQueued{ 0 };
+
+          public:
+            /*Returns a call with a zeroed parameter frame, fill it through GetParams then Submit it*/
+            FQueuedCall *AllocateCall( UObject *Object, UFunction *Function );
+            void Submit( FQueuedCall *Call );
+
+            /*Runs every call queued so far in submission order. Game thread only.*/
+            int32_t Drain();
+
+            int32_t GetNumQueued() const { return NumQueued.load( std::memory_order_relaxed ); }
+
+          private:
+            static void FreeCall( FQueuedCall *Call );
+	};
+}
@@ -0,0 +1,117 @@
+#pragma once
+namespace SDK
+{
+    /**
+     * Minimal streaming JSON writer, appends straight to a string.
+     * There is no DOM: keys and values go out in the order they're written and
+     * the only state kept is whether the next token needs a comma. If a file is
+     * attached the buffer is flushed into it every FlushThreshold bytes, so it
+     * never grows past that no matter how much gets exported.
+     */
+    class FJsonWriter
+    {
+          public:
+            static constexpr size_t FlushThreshold = 64 * 1024;
+
+            explicit FJsonWriter( std::string &InOut, std::ofstream *InFile = nullptr )
+                : Out( InOut ), File( InFile ) {}
+            ~FJsonWriter() { Flush(); }
+
+            void BeginObject() { Separator(); Out += '{'; bNeedComma = false; }
+            void EndObject() { Out += '}'; bNeedComma = true; MaybeFlush(); }
+            void BeginArray() { Separator(); Out += '['; bNeedComma = false; }
+            void EndArray() { Out += ']'; bNeedComma = true; MaybeFlush(); }
+
+            void Key( std::string_view Name ) {
+                    Separator();
+                    WriteEscaped( Name );
+                    Out += ':';
+                    bNeedComma = false;
+            }
+
+            void Null() { Separator(); Out += "null"; bNeedComma = true; }
+            void Bool( bool bValue ) {
+                    Separator();
+                    Out += bValue ? "true" : "false";
+                    bNeedComma = true;
+            }
+            void String( std::string_view Value ) {
+                    Separator();
+                    WriteEscaped( Value );
+                    bNeedComma = true;
+            }
+            /*UTF-16 in, UTF-8 out*/
+            void WideString( const wchar_t *Value, size_t Length );
+            void Name( const FName &Value );
+
+            template <typename T> void Number( T Value ) {
+                    if constexpr ( std::is_floating_point_v<T> ) {
+                            if ( !std::isfinite( Value ) ) {
+                                    Null();
+                                    return;
+                            }
+                    }
+                    Separator();
+                    char Buffer[32];
+                    auto Result = std::to_chars( Buffer, Buffer + sizeof( Buffer ), Value );
+                    Out.append( Buffer, Result.ptr );
+                    bNeedComma = true;
+            }
+
+            void Flush();
+
+          private:
+            FORCEINLINE void Separator() {
+                    if ( bNeedComma )
+                            Out += ',';
+            }
+            FORCEINLINE void MaybeFlush() {
+                    if ( File && Out.size() >= FlushThreshold )
+                            Flush();
+            }
+            void WriteEscaped( std::string_view Value );
+
+            std::string &Out;
+            std::ofstream *File;
+            /*Reused for every name and wide string so converting one doesn't allocate*/
+            std::string Scratch;
+            bool bNeedComma = false;
+    };
+
+    struct FExportOptions
+    {
+            /*How many objects and structs deep the export goes, deeper values are written as references*/
+            int32_t MaxDepth = 4;
+            /*Expand every referenced object instead of only the ones outered to the object being written*/
+            bool bFollowAllReferences = false;
+    };
+
+    /**
+     * Writes objects as JSON through the reflection layer, no per type formatter.
+     * Every object is written once per export; a second reference to it, one past
+     * MaxDepth, or one that isn't a subobject is written as
+     * {"$ref":Name,"$index":InternalIndex} instead, which also breaks cycles.
+     */
+	class FKismetExportLibrary
+	{
+          public:
+            /*Appends Object to Out, Out can be reused between calls to keep its capacity*/
+            void ExportObject( UObject *Object, std::string &Out,
+                               const FExportOptions &Options = {} );
+            /*Appends a JSON array of Objects to Out*/
+            void ExportObjects( const std::vector<UObject *> &Objects, std::string &Out,
+                                const FExportOptions &Options = {} );
+            bool ExportObjectsToFile( const std::vector<UObject *> &Objects,
+                                      const std::string &Path,
+                                      const FExportOptions &Options = {} );
+
+            /*Properties of Struct sorted by offset, so exports keep the declaration order*/
+            const std::vector<const FPropertyInfo *> &GetSortedProperties( UStruct *Struct );
+
+          private:
+            std::unordered_map<UStruct *, std::vector<const FPropertyInfo *>> SortedProperties;
+            std::shared_mutex SortedPropertiesLock;
+	};
+
+    extern std::unique_ptr<FKismetExportLibrary> ExportLibrary;
+}
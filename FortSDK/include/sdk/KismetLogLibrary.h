@@ -147,6 +147,20 @@ inline std::wstring GetTimestampW() {
         return oss.str();
 }
 
+/*GetTimestampA's format written into Buffer, the log path itself never allocates*/
+inline void FormatTimestamp( char ( &Buffer )[32] ) {
+        auto now = std::chrono::system_clock::now();
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      now.time_since_epoch() ) %
+                  1000;
+        std::time_t now_c = std::chrono::system_clock::to_time_t( now );
+        std::tm timeinfo{};
+        localtime_s( &timeinfo, &now_c );
+        const size_t Len =
+            std::strftime( Buffer, sizeof( Buffer ), "%Y.%m.%d-%H.%M.%S", &timeinfo );
+        snprintf( Buffer + Len, sizeof( Buffer ) - Len, ":%03d", int( ms.count() ) );
+}
+
 inline void UELogImpl( FLogCategory &Category, ELogLevel Level, const char *fmt,
                        ... ) {
         if ( (int)Level > (int)Category.RuntimeVerbosity )
@@ -159,9 +173,12 @@ inline void UELogImpl( FLogCategory &Category, ELogLevel Level, const char *fmt,
         vsnprintf( buffer, sizeof( buffer ), fmt, args );
         va_end( args );
 
+        char timestamp[32];
+        FormatTimestamp( timestamp );
+
         SetConsoleColorByLogLevel( Level );
 
-        std::cout << "[" << GetTimestampA() << "]" << Category.Name << ": "
+        std::cout << "[" << timestamp << "]" << Category.Name << ": "
                   << ToString( Level ) << ": " << buffer << std::endl;
 
         ResetConsoleColor();
@@ -183,16 +200,19 @@ inline void UELogWImpl( FLogCategory &Category, ELogLevel Level, const wchar_t *
         vswprintf( wbuffer, sizeof( wbuffer ) / sizeof( wchar_t ), fmt, args );
         va_end( args );
 
-        std::string Categorydih = std::string( Category.Name );
-        std::wstring WDih =
-            std::wstring( Categorydih.begin(), Categorydih.end() );
-        
-        std::wstring wfinal = std::wstring( wbuffer );
-        std::string finalbuf = WStringToUTF8( wfinal );
+        /*Narrowed the same way WStringToUTF8 does, without the two copies*/
+        char finalbuf[2048];
+        size_t i = 0;
+        for ( ; wbuffer[i] && i < sizeof( finalbuf ) - 1; i++ )
+                finalbuf[i] = char( wbuffer[i] );
+        finalbuf[i] = 0;
+
+        char timestamp[32];
+        FormatTimestamp( timestamp );
 
         SetConsoleColorByLogLevel( Level );
 
-        std::cout << "[" << GetTimestampA() << "] " << Category.Name << ": "
+        std::cout << "[" << timestamp << "] " << Category.Name << ": "
                   << ToString( Level ) << ": " << finalbuf << std::endl;
 
         ResetConsoleColor();
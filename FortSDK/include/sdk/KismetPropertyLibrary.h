@@ -7,6 +7,8 @@ namespace SDK
         int32_t Offset;
         std::string ClassName;
         std::string PropName;
+        /*Typed view of Prop, used to check reads against the real element size*/
+        FPropertyRef Ref;
 
         FPropertyInfo() = default;
 
@@ -20,6 +22,131 @@ namespace SDK
             std::string ClassName;
     };
 
+    /*Lets the name maps be probed with a string_view without building a std::string first*/
+    struct FNameStringHash {
+            using is_transparent = void;
+
+            size_t operator()( std::string_view Name ) const {
+                    return std::hash<std::string_view>{}( Name );
+            }
+    };
+
+    template <typename ValueType>
+    using TNameMap = std::unordered_map<std::string, ValueType, FNameStringHash,
+                                        std::equal_to<>>;
+
+    /**
+     * Flattened reflection data for a single UStruct.
+     * Properties holds every property reachable from Struct, including the ones
+     * declared somewhere up the SuperStruct chain, so a lookup never has to
+     * know which ancestor declares the member. Functions works the same way
+     * for every UFunction the struct declares or inherits.
+     */
+    struct FStructInfo
+    {
+            UStruct *Struct = nullptr;
+            TNameMap<FPropertyInfo> Properties;
+            TNameMap<FFunctionInfo> Functions;
+    };
+
+    /*How a parameter on the function's DestructorLink gets torn down when its frame is released*/
+    enum class EParamCleanup : uint8_t {
+            None,
+            /*FString and TArray, the engine allocation behind Data is freed along with what its elements own*/
+            FreeAllocation,
+            /*Needs a destructor we can't call, left alone*/
+            Unsupported
+    };
+
+    /*Immutable layout of one UFunction parameter, read once from reflection*/
+    struct FParamInfo
+    {
+            void *Prop = nullptr;
+            int32_t Offset = -1;
+            int32_t Size = 0;
+            int32_t ElementSize = 0;
+            int32_t ArrayDim = 0;
+            EPropertyFlags PropertyFlags = CPF_None;
+            EParamCleanup Cleanup = EParamCleanup::None;
+
+            bool IsOut() const { return ( PropertyFlags & CPF_OutParm ) != 0; }
+            bool IsRef() const {
+                    return ( PropertyFlags & CPF_ReferenceParm ) != 0;
+            }
+            bool IsReturn() const {
+                    return ( PropertyFlags & CPF_ReturnParm ) != 0;
+            }
+    };
+
+    /**
+     * Parameter layout of a UFunction, built once and reused by every call.
+     * Params holds the arguments in declaration order, ReturnValue has an Offset of
+     * -1 when the function returns nothing.
+     */
+    struct FFunctionParamsInfo
+    {
+            UFunction *Func = nullptr;
+            int32_t ParmsSize = 0;
+            std::vector<FParamInfo> Params;
+            FParamInfo ReturnValue;
+            /*FUNC_Native as Func had it when this was built, before any caller forced it*/
+            bool bWasNative = false;
+            /*Calls running with FUNC_Native forced by UObject::ProcessEventAsNative, the flag is set whenever this is above 0*/
+            mutable std::atomic<int32_t> NumForcingNative{ 0 };
+            /*Taken only to move NumForcingNative between 0 and 1, which is when FunctionFlags changes*/
+            mutable std::mutex ForceNativeLock;
+
+            size_t NumParams() const {
+                    return Params.size() + ( ReturnValue.Offset != -1 );
+            }
+
+            /**
+             * Destroys the values in a parameter buffer that nobody else owns: pure out
+             * params whose bit isn't set in CallerOwnedMask, params whose bit is set in
+             * OwnedInputMask and, if asked, the return value.
+             */
+            void DestroyParams( uint8_t *Data, uint64_t CallerOwnedMask,
+                                bool bDestroyReturnValue,
+                                uint64_t OwnedInputMask = 0 ) const;
+    };
+
+    /**
+     * Parameter buffer for a single call of a UFunction.
+     * Small frames live inside the object itself (so on the caller's stack), bigger
+     * ones come from the thread's FMemStack. Releasing the frame destroys the
+     * non-POD values the engine wrote into it that nobody took ownership of.
+     */
+    class FFunctionParamsFrame
+    {
+          public:
+            static constexpr int32_t InlineSize = 256;
+
+            explicit FFunctionParamsFrame( const FFunctionParamsInfo *InInfo );
+            ~FFunctionParamsFrame();
+
+            FFunctionParamsFrame( const FFunctionParamsFrame & ) = delete;
+            FFunctionParamsFrame &operator=( const FFunctionParamsFrame & ) = delete;
+
+            FORCEINLINE uint8_t *GetData() const { return Data; }
+
+            /*The caller wrote Params[ParamIndex] and still owns whatever it points to*/
+            FORCEINLINE void MarkCallerOwned( size_t ParamIndex ) {
+                    if ( ParamIndex < 64 )
+                            CallerOwnedMask |= uint64_t( 1 ) << ParamIndex;
+            }
+
+            /*The return value was moved out to the caller, don't destroy it*/
+            FORCEINLINE void ReleaseReturnValue() { bOwnsReturnValue = false; }
+
+          private:
+            const FFunctionParamsInfo *Info;
+            FMemMark Mark;
+            uint8_t *Data;
+            uint64_t CallerOwnedMask = 0;
+            bool bOwnsReturnValue = true;
+            alignas( 16 ) uint8_t InlineData[InlineSize];
+    };
+
     class FKismetPropertyManager
     {
           public:
@@ -27,16 +154,38 @@ namespace SDK
 
           public:
             int GetOffset();
+            int GetElementSize();
+            int GetArrayDim();
+            EPropertyFlags GetPropertyFlags();
+            std::string GetName();
+            /*Name of the property's class, e.g. StrProperty*/
+            std::string GetClassName();
     };
 
 	class FKismetPropertyLibrary
 	{
           public:
-            std::vector<FPropertyInfo> AllPropertyInfo;
-            std::vector<FFunctionInfo> AllFunctionInfo;
+            std::unordered_map<UStruct *, std::unique_ptr<FStructInfo>> AllStructInfo;
+            std::unordered_map<UFunction *, std::unique_ptr<FFunctionParamsInfo>>
+                AllFunctionParamsInfo;
+
+          private:
+            std::shared_mutex StructInfoLock;
+            std::shared_mutex FunctionParamsInfoLock;
+
           public:
-            FPropertyInfo GetPropertyByName( const std::string& ClassName, const std::string& PropName );
-            FFunctionInfo GetFunctionByName( const std::string &ClassName,
-                                             const std::string &FunctionName );
+            /*Built lazily once per struct by merging the SuperStruct's map with the struct's own properties*/
+            const FStructInfo *GetStructInfo( UStruct *Struct );
+
+            const FPropertyInfo &GetPropertyByName( const std::string& ClassName, const std::string& PropName );
+            const FPropertyInfo &GetPropertyByName( UStruct *Struct,
+                                                    std::string_view PropName );
+            const FFunctionInfo &GetFunctionByName( const std::string &ClassName,
+                                                    const std::string &FunctionName );
+            const FFunctionInfo &GetFunctionByName( UStruct *Struct,
+                                                    std::string_view FunctionName );
+
+            /*Parameter layout of Func, the reflection walk only happens on the first call*/
+            const FFunctionParamsInfo *GetFunctionParamsInfo( UFunction *Func );
 	};
-}
\ No newline at end of file
+}
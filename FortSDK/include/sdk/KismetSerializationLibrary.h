@@ -0,0 +1,89 @@
+#pragma once
+namespace SDK
+{
+    /*What one step of a serialization layout reads or writes*/
+    enum class ESerializeOp : uint8_t {
+            /*Size raw bytes, adjacent plain old data properties merged together*/
+            Span,
+            /*FString, int32 length then the characters*/
+            Str,
+            /*UObject pointer, written as its GUObjectArray index and serial number, read back as null if it has no serial or the slot was reused*/
+            Object,
+            /*TArray, int32 count then every element through Inner*/
+            Array,
+            /*Struct with non-POD members, recurses into its own layout*/
+            Struct
+    };
+
+    struct FSerializeOp
+    {
+            ESerializeOp Op = ESerializeOp::Span;
+            int32_t Offset = 0;
+            /*Span length, or the element size for every other op*/
+            int32_t Size = 0;
+            int32_t ArrayDim = 1;
+            /*Array element size*/
+            int32_t Stride = 0;
+            UStruct *Struct = nullptr;
+            /*Element of an Array, its Offset is always 0*/
+            std::unique_ptr<FSerializeOp> Inner;
+    };
+
+    /**
+     * Every reflected property of a struct, sorted by offset and reduced to the
+     * ops above. Built once per UStruct; a struct made only of POD members ends
+     * up as a handful of Spans and gets inlined into whoever contains it.
+     */
+    struct FSerializationLayout
+    {
+            UStruct *Struct = nullptr;
+            std::vector<FSerializeOp> Ops;
+            /*Properties that can't be serialized (maps, sets, text, delegates) and were left out*/
+            int32_t NumSkipped = 0;
+
+            bool IsPlainOldData() const {
+                    return std::all_of( Ops.begin(), Ops.end(), []( const FSerializeOp &Op ) {
+                            return Op.Op == ESerializeOp::Span;
+                    } );
+            }
+    };
+
+    /**
+     * Binary serializer for UObjects and struct instances driven by reflection.
+     * The stream starts with the struct size as a sanity check and otherwise
+     * only contains property data, in offset order. FNames are written as
+     * their raw index pair, so both ends have to share a name table.
+     */
+	class FKismetSerializationLibrary
+	{
+          public:
+            const FSerializationLayout *GetLayout( UStruct *Struct );
+
+            bool SerializeStruct( UStruct *Struct, const void *Data,
+                                  std::vector<uint8_t> &Out );
+            bool DeserializeStruct( UStruct *Struct, void *Data,
+                                    const uint8_t *In, size_t Size );
+
+            bool SerializeObject( UObject *Object, std::vector<uint8_t> &Out ) {
+                    return Object &&
+                           SerializeStruct( Object->GetClass(), Object, Out );
+            }
+            bool DeserializeObject( UObject *Object, const uint8_t *In,
+                                    size_t Size ) {
+                    return Object &&
+                           DeserializeStruct( Object->GetClass(), Object, In, Size );
+            }
+
+            /**
+             * Serializes Object Iterations times, then reads the result back into
+             * it as many times, and logs the throughput of both in MB/s.
+             */
+            void BenchmarkSerialization( UObject *Object, int32_t Iterations = 1000 );
+
+          private:
+            std::unordered_map<UStruct *, std::unique_ptr<FSerializationLayout>> Layouts;
+            std::shared_mutex LayoutsLock;
+	};
+
+    extern std::unique_ptr<FKismetSerializationLibrary> SerializationLibrary;
+}
@@ -0,0 +1,103 @@
+#pragma once
+namespace SDK
+{
+    /*One property whose bytes differ from the previous Capture*/
+    struct FPropertyChange
+    {
+            UObject *Object;
+            const FPropertyRef *Property;
+    };
+
+    /**
+     * The POD regions of a class packed back to back, plus the properties that
+     * live in them sorted by offset so a changed byte maps back to its property
+     * with a binary search.
+     */
+    struct FSnapshotLayout
+    {
+            struct FSpan
+            {
+                    int32_t SrcOffset;
+                    int32_t Size;
+                    int32_t PackedOffset;
+            };
+
+            struct FProp
+            {
+                    int32_t Offset;
+                    int32_t End;
+                    const FPropertyRef *Ref;
+                    /*Bits of the byte at Offset this property owns, bitfield bools share that byte with each other*/
+                    uint8_t FieldMask;
+            };
+
+            std::vector<FSpan> Spans;
+            std::vector<FProp> Props;
+            /*Rounded up to 16 so every object starts on a block boundary*/
+            int32_t PackedSize = 0;
+
+            /*Properties covering byte Offset of the object as [First, Last), empty if it isn't tracked. More than one only for bitfield bools*/
+            std::pair<const FProp *, const FProp *> FindProps( int32_t Offset ) const;
+            /*Object offset of a byte in the packed copy*/
+            int32_t PackedToSrc( int32_t PackedOffset ) const;
+    };
+
+    /**
+     * Change detection for a set of objects.
+     * Capture copies the POD regions of every tracked object into one contiguous
+     * buffer and compares it with the previous one 16 bytes at a time, only the
+     * blocks that differ are looked at byte by byte.
+     */
+	class FKismetSnapshotLibrary
+	{
+          public:
+            /*Ignored if the engine can't give Object a serial number to notice it being destroyed by*/
+            void Track( UObject *Object );
+            void Untrack( UObject *Object );
+            void Clear();
+
+            int32_t GetNumTracked() const { return int32_t( Entries.size() ); }
+
+            /**
+             * Snapshots every tracked object and appends to OutChanges the properties
+             * that changed since the previous Capture. Objects captured for the first
+             * time report nothing, objects that were destroyed are dropped.
+             */
+            void Capture( std::vector<FPropertyChange> &OutChanges );
+
+            const FSnapshotLayout *GetLayout( UClass *Class );
+
+          private:
+            struct FEntry
+            {
+                    UObject *Object;
+                    int32_t Index;
+                    int32_t SerialNumber;
+                    const FSnapshotLayout *Layout;
+                    /*Byte offset of this object's packed copy in the buffers*/
+                    size_t Offset;
+                    bool bHasBaseline;
+            };
+
+            /*Packs the entries again and resizes both buffers, carrying over each entry's previous snapshot*/
+            void Relayout();
+
+            std::vector<FEntry> Entries;
+            bool bNeedsRelayout = false;
+
+            /*16 byte aligned, Previous and Current swap after every Capture*/
+            struct FAlignedBuffer
+            {
+                    std::unique_ptr<__m128i[]> Blocks;
+                    size_t NumBlocks = 0;
+
+                    uint8_t *Data() { return reinterpret_cast<uint8_t *>( Blocks.get() ); }
+            };
+            FAlignedBuffer Previous;
+            FAlignedBuffer Current;
+
+            std::unordered_map<UClass *, std::unique_ptr<FSnapshotLayout>> Layouts;
+	};
+
+    extern std::unique_ptr<FKismetSnapshotLibrary> SnapshotLibrary;
+}
@@ -0,0 +1,173 @@
+#pragma once
+namespace SDK
+{
+    /**
+     * Fire and forget coroutine. It starts running as soon as it's called and
+     * frees itself when it returns, anything it awaits resumes it from
+     * TaskLibrary->Pump() on the game thread.
+     *
+     * FTask GiveItems( APlayerController *PC ) {
+     *         AFortPawn *Pawn = co_await WaitForObject<AFortPawn>( "PlayerPawn_Athena_C_0" );
+     *         co_await NextTick();
+     *         ...
+     * }
+     */
+    struct FTask
+    {
+            struct promise_type
+            {
+                    FTask get_return_object() noexcept { return {}; }
+                    std::suspend_never initial_suspend() noexcept { return {}; }
+                    std::suspend_never final_suspend() noexcept { return {}; }
+                    void return_void() noexcept {}
+                    void unhandled_exception() noexcept {
+                            UE_LOG( LogFortSDK, Error,
+                                    "Unhandled exception in FTask, the task was dropped" );
+                    }
+            };
+    };
+
+    /**
+     * Resumes suspended coroutines from the game thread.
+     * Nothing here owns a thread, a waiting task is just a coroutine handle in
+     * one of the lists below until Pump picks it up, so the cost of a task is
+     * its coroutine frame. Pump has to be called once per tick from whatever
+     * game thread hook the plugin already has.
+     */
+	class FKismetTaskLibrary
+	{
+          public:
+            /*How many pumps go by between two GUObjectArray scans for WaitForObject, new waiters get one on the next pump*/
+            int32_t ObjectScanInterval = 30;
+
+            FKismetTaskLibrary() = default;
+
+            FKismetTaskLibrary( const FKismetTaskLibrary & ) = delete;
+            FKismetTaskLibrary &operator=( const FKismetTaskLibrary & ) = delete;
+
+            /*Resumes everything that became ready since the last call. Game thread only.*/
+            void Pump();
+
+            /*True once Pump has run on the calling thread*/
+            bool IsInGameThread() const {
+                    return GameThreadId.load( std::memory_order_relaxed ) ==
+                           std::this_thread::get_id();
+            }
+
+            int32_t GetNumPending() const {
+                    return NumPending.load( std::memory_order_relaxed );
+            }
+
+            void ScheduleNextTick( std::coroutine_handle<> Handle );
+            void RunOnGameThread( std::function<void()> Fn );
+            /*Resumes Handle once an object called Name (of Class, if set) exists, or with nullptr after MaxTicks pumps when MaxTicks > 0*/
+            void WaitForObject( std::string Name, UClass *Class, UObject **OutObject,
+                                int32_t MaxTicks, std::coroutine_handle<> Handle );
+
+          private:
+            struct FObjectWaiter
+            {
+                    std::string Name;
+                    UClass *Class;
+                    UObject **OutObject;
+                    int32_t TicksLeft;
+                    std::coroutine_handle<> Handle;
+            };
+
+            void PumpObjectWaiters();
+
+            std::mutex Lock;
+            std::vector<std::coroutine_handle<>> Ready;
+            std::vector<std::function<void()>> Calls;
+            std::vector<FObjectWaiter> ObjectWaiters;
+
+            std::atomic<std::thread::id> GameThreadId{};
+            std::atomic<int32_t> NumPending{ 0 };
+            int32_t PumpsSinceScan = 0;
+            /*Set under Lock by WaitForObject, the next pump scans for every new waiter at once*/
+            bool bNewObjectWaiters = false;
+	};
+
+    extern std::unique_ptr<FKismetTaskLibrary> TaskLibrary;
+
+    struct FNextTickAwaiter
+    {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend( std::coroutine_handle<> Handle ) const {
+                    TaskLibrary->ScheduleNextTick( Handle );
+            }
+            void await_resume() const noexcept {}
+    };
+
+    /*co_await NextTick(); continues on the game thread during the next Pump*/
+    inline FNextTickAwaiter NextTick() { return {}; }
+
+    template <typename T> struct TWaitForObjectAwaiter
+    {
+            std::string Name;
+            int32_t MaxTicks = 0;
+            UObject *Found = nullptr;
+
+            bool await_ready() const noexcept { return false; }
+            /*No walk here, an object that already exists is found by the scan of the next pump*/
+            void await_suspend( std::coroutine_handle<> Handle ) {
+                    UClass *Class = nullptr;
+                    if constexpr ( !std::is_same_v<T, UObject> )
+                            Class = T::StaticClass();
+                    TaskLibrary->WaitForObject( std::move( Name ), Class, &Found,
+                                                MaxTicks, Handle );
+            }
+            T *await_resume() const noexcept { return static_cast<T *>( Found ); }
+    };
+
+    /**
+     * co_await WaitForObject<T>( Name ) resumes with the first object called Name
+     * that is a T, at the earliest on the next Pump. With MaxTicks set it gives
+     * up after that many pumps and resumes with nullptr.
+     */
+    template <typename T = UObject>
+    TWaitForObjectAwaiter<T> WaitForObject( std::string Name, int32_t MaxTicks = 0 ) {
+            return TWaitForObjectAwaiter<T>{ std::move( Name ), MaxTicks };
+    }
+
+    template <typename F> struct TGameThreadCallAwaiter
+    {
+            using ResultType = std::invoke_result_t<F &>;
+
+            F Fn;
+            bool bDone = false;
+            std::conditional_t<std::is_void_v<ResultType>, bool, ResultType>
+                Result{};
+
+            void Run() {
+                    if constexpr ( std::is_void_v<ResultType> )
+                            Fn();
+                    else
+                            Result = Fn();
+                    bDone = true;
+            }
+
+            /*Already on the game thread, just run it inline*/
+            bool await_ready() const { return TaskLibrary->IsInGameThread(); }
+            void await_suspend( std::coroutine_handle<> Handle ) {
+                    TaskLibrary->RunOnGameThread( [this, Handle] {
+                            Run();
+                            Handle.resume();
+                    } );
+            }
+            ResultType await_resume() {
+                    if ( !bDone )
+                            Run();
+                    if constexpr ( !std::is_void_v<ResultType> )
+                            return std::move( Result );
+            }
+    };
+
+    /**
+     * co_await CallOnGameThread( Fn ) runs Fn during the next Pump and resumes
+     * the task right after it, with Fn's return value.
+     */
+    template <typename F> TGameThreadCallAwaiter<std::decay_t<F>> CallOnGameThread( F &&Fn ) {
+            return TGameThreadCallAwaiter<std::decay_t<F>>{ std::forward<F>( Fn ) };
+    }
+}
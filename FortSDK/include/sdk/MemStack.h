@@ -0,0 +1,162 @@
+#pragma once
+
+namespace SDK
+{
+/**
+ * Per-thread bump allocator for short lived SDK allocations.
+ * Memory is handed out by moving Top forward and is only ever given back by
+ * popping an FMemMark, so allocating is a pointer bump and freeing a whole
+ * scope is two stores. Chunks are kept around for reuse once popped.
+ */
+class FMemStack
+{
+      public:
+        static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+        FMemStack() = default;
+        FMemStack( const FMemStack & ) = delete;
+        FMemStack &operator=( const FMemStack & ) = delete;
+        ~FMemStack();
+
+        /** Returns the calling thread's stack. */
+        static FMemStack &Get();
+
+        FORCEINLINE uint8_t *PushBytes( size_t Size, size_t Alignment ) {
+                uint8_t *Result = AlignPtr( Top, Alignment );
+                uint8_t *NewTop = Result + Size;
+                if ( Result && NewTop <= End ) {
+                        Top = NewTop;
+                        return Result;
+                }
+
+                AllocateNewChunk( Size + Alignment );
+                Result = AlignPtr( Top, Alignment );
+                Top = Result + Size;
+                return Result;
+        }
+
+        template <typename T> FORCEINLINE T *Push( size_t Count = 1 ) {
+                return reinterpret_cast<T *>(
+                    PushBytes( sizeof( T ) * Count, alignof( T ) ) );
+        }
+
+        /** Returns true if nothing is currently allocated from this stack. */
+        bool IsEmpty() const { return TopChunk == nullptr; }
+
+        int32_t GetNumMarks() const { return NumMarks; }
+
+      private:
+        struct FChunk {
+                FChunk *Next;
+                size_t DataSize;
+
+                uint8_t *Data() { return reinterpret_cast<uint8_t *>( this + 1 ); }
+        };
+
+        static FORCEINLINE uint8_t *AlignPtr( uint8_t *Ptr, size_t Alignment ) {
+                return reinterpret_cast<uint8_t *>(
+                    ( reinterpret_cast<uintptr_t>( Ptr ) + Alignment - 1 ) &
+                    ~( uintptr_t( Alignment ) - 1 ) );
+        }
+
+        void AllocateNewChunk( size_t MinSize );
+        /** Moves every chunk above NewTopChunk back to the unused list. */
+        void FreeChunks( FChunk *NewTopChunk );
+
+        uint8_t *Top = nullptr;
+        uint8_t *End = nullptr;
+        FChunk *TopChunk = nullptr;
+        FChunk *UnusedChunks = nullptr;
+        int32_t NumMarks = 0;
+
+        friend class FMemMark;
+};
+
+/**
+ * Remembers the top of an FMemStack and releases everything pushed after it
+ * when it goes out of scope. Marks must be popped in reverse order.
+ */
+class FMemMark
+{
+      public:
+        explicit FMemMark( FMemStack &InMem )
+            : Mem( InMem ), Top( InMem.Top ), SavedChunk( InMem.TopChunk ) {
+                ++Mem.NumMarks;
+        }
+
+        FMemMark( const FMemMark & ) = delete;
+        FMemMark &operator=( const FMemMark & ) = delete;
+
+        ~FMemMark() { Pop(); }
+
+        void Pop() {
+                if ( bPopped )
+                        return;
+                bPopped = true;
+
+                if ( SavedChunk != Mem.TopChunk )
+                        Mem.FreeChunks( SavedChunk );
+
+                Mem.Top = Top;
+                Mem.End = SavedChunk ? SavedChunk->Data() + SavedChunk->DataSize
+                                     : nullptr;
+                --Mem.NumMarks;
+        }
+
+      private:
+        FMemStack &Mem;
+        uint8_t *Top;
+        FMemStack::FChunk *SavedChunk;
+        bool bPopped = false;
+};
+
+/**
+ * std::pmr face of an FMemStack. Deallocating does nothing, the memory comes
+ * back when the FMemMark below it pops, so a pmr container that grows leaves
+ * its old buffers behind until then.
+ */
+class FMemStackResource final : public std::pmr::memory_resource
+{
+      public:
+        explicit FMemStackResource( FMemStack &InMem ) : Mem( InMem ) {}
+
+      private:
+        void *do_allocate( size_t Bytes, size_t Alignment ) override {
+                return Mem.PushBytes( Bytes, Alignment );
+        }
+
+        void do_deallocate( void *, size_t, size_t ) override {}
+
+        bool do_is_equal( const std::pmr::memory_resource &Other ) const noexcept override {
+                return this == &Other;
+        }
+
+        FMemStack &Mem;
+};
+
+/**
+ * Scratch scope for temporaries: marks the calling thread's FMemStack and
+ * hands out a resource for std::pmr containers. Anything built on
+ * GetResource() must be gone before the scope is.
+ *
+ * {
+ *      FMemStackScope Scope;
+ *      std::pmr::string Name( Scope.GetResource() );
+ * }
+ */
+class FMemStackScope
+{
+      public:
+        FMemStackScope() : FMemStackScope( FMemStack::Get() ) {}
+        explicit FMemStackScope( FMemStack &Mem ) : Mark( Mem ), Resource( Mem ) {}
+
+        FMemStackScope( const FMemStackScope & ) = delete;
+        FMemStackScope &operator=( const FMemStackScope & ) = delete;
+
+        std::pmr::memory_resource *GetResource() { return &Resource; }
+
+      private:
+        FMemMark Mark;
+        FMemStackResource Resource;
+};
+}
@@ -13,15 +13,76 @@ enum {
 
 namespace SDK
 {
+/**
+ * What the SDK allocated through FMemory since it loaded. Frees only count
+ * blocks the SDK allocated itself, releasing one of the engine's (a returned
+ * FString, say) doesn't show up. A block handed over to the engine stays live
+ * here after the engine frees it, the SDK never sees that.
+ */
+struct FMemoryStats {
+        /*Requested bytes of every allocation so far*/
+        uint64_t AllocatedBytes;
+        uint64_t Allocations;
+        uint64_t Frees;
+        /*Bytes the SDK has on the engine heap right now, as GetAllocSize reports them when it's resolved*/
+        uint64_t LiveBytes;
+
+        int64_t GetLiveAllocations() const {
+                return int64_t( Allocations - Frees );
+        }
+};
+
+/**
+ * The engine's allocator (GMalloc). Realloc is found by pattern, the rest
+ * are read out of GMalloc's vtable by ResolveFromRealloc. Malloc and Free
+ * fall back to Realloc if that fails, which is what the engine does anyway.
+ */
 class FMemory {
       public:
-          static void* Realloc(void* Original, UINT64 Size,
-                              UINT32 Alignment = 8 ) {
-                static void* ( *InternalRealloc )( void *Original, UINT64 Size,
-                                                  UINT32 Alignment ) = decltype(InternalRealloc)(Offsets::FMemory__Realloc);
-                  return InternalRealloc( Original, Size, Alignment );
-          }
+        static void *Malloc( UINT64 Count, UINT32 Alignment = DEFAULT_ALIGNMENT );
+        static void *Realloc( void *Original, UINT64 Size, UINT32 Alignment = 8 );
+        static void Free( void *Original );
+
+        /** Size of the block Original points to, 0 if it isn't known. */
+        static UINT64 GetAllocSize( void *Original );
+
+        /** Size Malloc would really hand out for Count bytes. */
+        static UINT64 QuantizeSize( UINT64 Count, UINT32 Alignment = DEFAULT_ALIGNMENT );
+
+        static FMemoryStats GetStats();
+
+        /**
+         * Finds GMalloc and its Malloc/Free from the code of FMemory::Realloc,
+         * plus QuantizeSize/GetAllocationSize on engine versions whose FMalloc
+         * layout is known. Needs Offsets::FMemory__Realloc and Engine_Version.
+         */
+        static bool ResolveFromRealloc();
 };
-}
 
+/**
+ * STL allocator on top of FMemory, for containers whose memory should live on
+ * the engine heap. Only usable after Init; MSVC's node containers allocate
+ * when they're constructed, so don't use it for statics built before that.
+ */
+template <typename T> struct TEngineAllocator {
+        using value_type = T;
+
+        TEngineAllocator() noexcept = default;
+        template <typename U>
+        TEngineAllocator( const TEngineAllocator<U> & ) noexcept {}
+
+        T *allocate( size_t Count ) {
+                void *Result = FMemory::Malloc( Count * sizeof( T ), alignof( T ) );
+                if ( !Result )
+                        throw std::bad_alloc();
+                return static_cast<T *>( Result );
+        }
 
+        void deallocate( T *Ptr, size_t ) noexcept { FMemory::Free( Ptr ); }
+
+        template <typename U>
+        bool operator==( const TEngineAllocator<U> & ) const noexcept {
+                return true;
+        }
+};
+}
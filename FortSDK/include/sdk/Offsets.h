@@ -6,8 +6,14 @@ namespace Offsets
 {
 extern uint64_t FMemory__Realloc;
 extern uint64_t FMemory__Free;
+extern uint64_t FMemory__Malloc;
+extern uint64_t FMemory__QuantizeSize;
+extern uint64_t FMemory__GetAllocSize;
+extern uint64_t GMalloc;
 extern uint64_t GUObjectArray__ObjObjects;
+extern uint64_t FUObjectArray__AllocateSerialNumber;
 extern uint64_t FName__ToString;
+extern uint64_t FName__FName;
 extern uint64_t UObject__ProcessEvent;
 namespace Members
 {
@@ -0,0 +1,436 @@
+#pragma once
+
+namespace SDK
+{
+/**
+ * Flags used for quickly casting classes of certain types; all class cast
+ * flags are inherited. Read from FFieldClass::CastFlags on FProperty builds,
+ * rebuilt from the property's UClass chain on UProperty builds (same bits,
+ * the UProperty names just start with U).
+ */
+enum EClassCastFlags : uint64 {
+        CASTCLASS_None = 0x0000000000000000,
+
+        CASTCLASS_UField = 0x0000000000000001,
+        CASTCLASS_FInt8Property = 0x0000000000000002,
+        CASTCLASS_UEnum = 0x0000000000000004,
+        CASTCLASS_UStruct = 0x0000000000000008,
+        CASTCLASS_UScriptStruct = 0x0000000000000010,
+        CASTCLASS_UClass = 0x0000000000000020,
+        CASTCLASS_FByteProperty = 0x0000000000000040,
+        CASTCLASS_FIntProperty = 0x0000000000000080,
+        CASTCLASS_FFloatProperty = 0x0000000000000100,
+        CASTCLASS_FUInt64Property = 0x0000000000000200,
+        CASTCLASS_FClassProperty = 0x0000000000000400,
+        CASTCLASS_FUInt32Property = 0x0000000000000800,
+        CASTCLASS_FInterfaceProperty = 0x0000000000001000,
+        CASTCLASS_FNameProperty = 0x0000000000002000,
+        CASTCLASS_FStrProperty = 0x0000000000004000,
+        CASTCLASS_FProperty = 0x0000000000008000,
+        CASTCLASS_FObjectProperty = 0x0000000000010000,
+        CASTCLASS_FBoolProperty = 0x0000000000020000,
+        CASTCLASS_FUInt16Property = 0x0000000000040000,
+        CASTCLASS_UFunction = 0x0000000000080000,
+        CASTCLASS_FStructProperty = 0x0000000000100000,
+        CASTCLASS_FArrayProperty = 0x0000000000200000,
+        CASTCLASS_FInt64Property = 0x0000000000400000,
+        CASTCLASS_FDelegateProperty = 0x0000000000800000,
+        CASTCLASS_FNumericProperty = 0x0000000001000000,
+        CASTCLASS_FMulticastDelegateProperty = 0x0000000002000000,
+        CASTCLASS_FObjectPropertyBase = 0x0000000004000000,
+        CASTCLASS_FWeakObjectProperty = 0x0000000008000000,
+        CASTCLASS_FLazyObjectProperty = 0x0000000010000000,
+        CASTCLASS_FSoftObjectProperty = 0x0000000020000000,
+        CASTCLASS_FTextProperty = 0x0000000040000000,
+        CASTCLASS_FInt16Property = 0x0000000080000000,
+        CASTCLASS_FDoubleProperty = 0x0000000100000000,
+        CASTCLASS_FSoftClassProperty = 0x0000000200000000,
+        CASTCLASS_UPackage = 0x0000000400000000,
+        CASTCLASS_ULevel = 0x0000000800000000,
+        CASTCLASS_AActor = 0x0000001000000000,
+        CASTCLASS_APlayerController = 0x0000002000000000,
+        CASTCLASS_APawn = 0x0000004000000000,
+        CASTCLASS_USceneComponent = 0x0000008000000000,
+        CASTCLASS_UPrimitiveComponent = 0x0000010000000000,
+        CASTCLASS_USkinnedMeshComponent = 0x0000020000000000,
+        CASTCLASS_USkeletalMeshComponent = 0x0000040000000000,
+        CASTCLASS_UBlueprint = 0x0000080000000000,
+        CASTCLASS_UDelegateFunction = 0x0000100000000000,
+        CASTCLASS_UStaticMeshComponent = 0x0000200000000000,
+        CASTCLASS_FMapProperty = 0x0000400000000000,
+        CASTCLASS_FSetProperty = 0x0000800000000000,
+        CASTCLASS_FEnumProperty = 0x0001000000000000,
+        CASTCLASS_USparseDelegateFunction = 0x0002000000000000,
+        CASTCLASS_FMulticastInlineDelegateProperty = 0x0004000000000000,
+        CASTCLASS_FMulticastSparseDelegateProperty = 0x0008000000000000,
+        CASTCLASS_FFieldPathProperty = 0x0010000000000000,
+        CASTCLASS_FObjectPtrProperty = 0x0020000000000000,
+        CASTCLASS_FClassPtrProperty = 0x0040000000000000,
+        CASTCLASS_FLargeWorldCoordinatesRealProperty = 0x0080000000000000,
+};
+
+/** The concrete property class, one entry per typed wrapper below. */
+enum class EPropertyType : uint8 {
+        Unknown,
+        Bool,
+        Int8,
+        Byte,
+        Int16,
+        UInt16,
+        Int,
+        UInt32,
+        Int64,
+        UInt64,
+        Float,
+        Double,
+        Name,
+        Str,
+        Text,
+        Object,
+        Class,
+        WeakObject,
+        LazyObject,
+        SoftObject,
+        SoftClass,
+        Interface,
+        Struct,
+        Array,
+        Map,
+        Set,
+        Enum,
+        Delegate,
+        MulticastDelegate,
+        FieldPath,
+
+        Num
+};
+
+/**
+ * Any property, whichever of FProperty500, FProperty or UProperty the build
+ * uses. The cast flags and the common fields are read once on construction,
+ * the typed wrappers below add the members of their own property class.
+ */
+class FPropertyRef
+{
+      public:
+        FPropertyRef() = default;
+        explicit FPropertyRef( void *InProp );
+
+        FORCEINLINE bool IsValid() const { return Prop != nullptr; }
+        FORCEINLINE void *Get() const { return Prop; }
+        FORCEINLINE uint64 GetCastFlags() const { return CastFlags; }
+        FORCEINLINE EPropertyType GetType() const { return Type; }
+        FORCEINLINE int32 GetOffset() const { return Offset; }
+        FORCEINLINE int32 GetElementSize() const { return ElementSize; }
+        FORCEINLINE int32 GetArrayDim() const { return ArrayDim; }
+        FORCEINLINE int32 GetSize() const { return ElementSize * ArrayDim; }
+        FORCEINLINE bool HasAnyCastFlags( uint64 Flags ) const {
+                return ( CastFlags & Flags ) != 0;
+        }
+
+        EPropertyFlags GetPropertyFlags() const;
+        std::string GetName() const;
+
+        FORCEINLINE void *ContainerPtrToValuePtr( const void *Container,
+                                                  int32 ArrayIndex = 0 ) const {
+                return reinterpret_cast<uint8 *>( const_cast<void *>( Container ) ) +
+                       Offset + ArrayIndex * ElementSize;
+        }
+
+        /**
+         * Value of this property inside Container as a T, or nullptr if T isn't
+         * the size of one element or ArrayIndex is out of range.
+         */
+        template <typename T>
+        T *GetValuePtr( const void *Container, int32 ArrayIndex = 0 ) const {
+                if ( !Prop || !Container || sizeof( T ) != size_t( ElementSize ) ||
+                     ArrayIndex < 0 || ArrayIndex >= ArrayDim ) {
+                        UE_LOG( LogFortSDK, Warning,
+                                "Rejected read of %s as a %zu byte value, element "
+                                "size is %d",
+                                GetName().c_str(), sizeof( T ), ElementSize );
+                        return nullptr;
+                }
+                return reinterpret_cast<T *>(
+                    ContainerPtrToValuePtr( Container, ArrayIndex ) );
+        }
+
+        /** Start of the members a property subclass adds after the base class. */
+        static uint32 GetSubclassMembersOffset();
+
+      protected:
+        template <typename T> FORCEINLINE T ReadMember( uint32 MemberOffset ) const {
+                return *reinterpret_cast<T *>( reinterpret_cast<uint8 *>( Prop ) +
+                                               GetSubclassMembersOffset() +
+                                               MemberOffset );
+        }
+
+        void *Prop = nullptr;
+        uint64 CastFlags = CASTCLASS_None;
+        int32 Offset = 0;
+        int32 ElementSize = 0;
+        int32 ArrayDim = 0;
+        EPropertyType Type = EPropertyType::Unknown;
+};
+
+class FBoolPropertyRef : public FPropertyRef
+{
+      public:
+        static constexpr uint64 StaticCastFlags = CASTCLASS_FBoolProperty;
+        using FPropertyRef::FPropertyRef;
+
+        /*Byte of the value the bool lives in, and the bits of it that are the bool*/
+        FORCEINLINE uint8 GetByteOffset() const { return ReadMember<uint8>( 1 ); }
+        FORCEINLINE uint8 GetFieldMask() const { return ReadMember<uint8>( 3 ); }
+
+        /*Bitfield bools share their byte with other properties, always go through the mask*/
+        bool GetPropertyValue( const void *Container, int32 ArrayIndex = 0 ) const {
+                const uint8 *Byte = static_cast<uint8 *>(
+                                        ContainerPtrToValuePtr( Container, ArrayIndex ) ) +
+                                    ReadMember<uint8>( 1 );
+                return ( *Byte & ReadMember<uint8>( 3 ) ) != 0;
+        }
+        void SetPropertyValue( void *Container, bool bValue,
+                               int32 ArrayIndex = 0 ) const {
+                uint8 *Byte = static_cast<uint8 *>(
+                                  ContainerPtrToValuePtr( Container, ArrayIndex ) ) +
+                              ReadMember<uint8>( 1 );
+                *Byte = ( *Byte & ~ReadMember<uint8>( 3 ) ) |
+                        ( bValue ? ReadMember<uint8>( 2 ) : 0 );
+        }
+};
+
+/** Properties holding a plain T: the numeric ones, FName and FString. */
+template <typename T, uint64 InCastFlags> class TPropertyValueRef : public FPropertyRef
+{
+      public:
+        using ValueType = T;
+        static constexpr uint64 StaticCastFlags = InCastFlags;
+        using FPropertyRef::FPropertyRef;
+
+        T *GetPropertyValuePtr( const void *Container, int32 ArrayIndex = 0 ) const {
+                return GetValuePtr<T>( Container, ArrayIndex );
+        }
+        T GetPropertyValue( const void *Container, int32 ArrayIndex = 0 ) const {
+                T *Value = GetPropertyValuePtr( Container, ArrayIndex );
+                return Value ? *Value : T{};
+        }
+};
+
+using FInt8PropertyRef = TPropertyValueRef<int8_t, CASTCLASS_FInt8Property>;
+using FInt16PropertyRef = TPropertyValueRef<int16_t, CASTCLASS_FInt16Property>;
+using FUInt16PropertyRef = TPropertyValueRef<uint16_t, CASTCLASS_FUInt16Property>;
+using FIntPropertyRef = TPropertyValueRef<int32, CASTCLASS_FIntProperty>;
+using FUInt32PropertyRef = TPropertyValueRef<uint32, CASTCLASS_FUInt32Property>;
+using FInt64PropertyRef = TPropertyValueRef<int64, CASTCLASS_FInt64Property>;
+using FUInt64PropertyRef = TPropertyValueRef<uint64, CASTCLASS_FUInt64Property>;
+using FFloatPropertyRef = TPropertyValueRef<float, CASTCLASS_FFloatProperty>;
+using FDoublePropertyRef = TPropertyValueRef<double, CASTCLASS_FDoubleProperty>;
+using FNamePropertyRef = TPropertyValueRef<FName, CASTCLASS_FNameProperty>;
+using FStrPropertyRef = TPropertyValueRef<FString, CASTCLASS_FStrProperty>;
+
+class FBytePropertyRef : public TPropertyValueRef<uint8, CASTCLASS_FByteProperty>
+{
+      public:
+        using TPropertyValueRef::TPropertyValueRef;
+
+        /** The UEnum this byte stores, nullptr for a plain uint8. */
+        UObject *GetEnum() const { return ReadMember<UObject *>( 0 ); }
+};
+
+/** Object, weak, lazy, soft and interface properties. */
+class FObjectPropertyRef : public FPropertyRef
+{
+      public:
+        static constexpr uint64 StaticCastFlags =
+            CASTCLASS_FObjectPropertyBase | CASTCLASS_FInterfaceProperty;
+        using FPropertyRef::FPropertyRef;
+
+        UClass *GetPropertyClass() const { return ReadMember<UClass *>( 0 ); }
+
+        /** Only hard object references can be read directly. */
+        UObject *GetObjectValue( const void *Container, int32 ArrayIndex = 0 ) const {
+                if ( !HasAnyCastFlags( CASTCLASS_FObjectProperty ) )
+                        return nullptr;
+                UObject **Value = GetValuePtr<UObject *>( Container, ArrayIndex );
+                return Value ? *Value : nullptr;
+        }
+};
+
+class FClassPropertyRef : public FObjectPropertyRef
+{
+      public:
+        static constexpr uint64 StaticCastFlags =
+            CASTCLASS_FClassProperty | CASTCLASS_FSoftClassProperty;
+        using FObjectPropertyRef::FObjectPropertyRef;
+
+        UClass *GetMetaClass() const { return ReadMember<UClass *>( 8 ); }
+};
+
+class FStructPropertyRef : public FPropertyRef
+{
+      public:
+        static constexpr uint64 StaticCastFlags = CASTCLASS_FStructProperty;
+        using FPropertyRef::FPropertyRef;
+
+        UStruct *GetStruct() const { return ReadMember<UStruct *>( 0 ); }
+};
+
+class FArrayPropertyRef : public FPropertyRef
+{
+      public:
+        static constexpr uint64 StaticCastFlags = CASTCLASS_FArrayProperty;
+        using FPropertyRef::FPropertyRef;
+
+        FPropertyRef GetInner() const;
+
+        /*Element type is whatever GetInner says, only Num and the raw Data are meaningful here*/
+        TArray<uint8> *GetArray( const void *Container, int32 ArrayIndex = 0 ) const {
+                return GetValuePtr<TArray<uint8>>( Container, ArrayIndex );
+        }
+
+        /*Elements stepped by the inner property's size, empty if the array can't be read*/
+        template <typename T = uint8>
+        TStridedArrayView<T> GetView( const void *Container,
+                                      int32 ArrayIndex = 0 ) const {
+                TArray<uint8> *Array = GetArray( Container, ArrayIndex );
+                const int32 Stride = GetInner().GetElementSize();
+                if ( !Array || Stride <= 0 )
+                        return {};
+                return TStridedArrayView<T>(
+                    reinterpret_cast<T *>( Array->GetData() ), Array->Num(),
+                    Stride );
+        }
+};
+
+class FMapPropertyRef : public FPropertyRef
+{
+      public:
+        static constexpr uint64 StaticCastFlags = CASTCLASS_FMapProperty;
+        using FPropertyRef::FPropertyRef;
+
+        FPropertyRef GetKeyProp() const {
+                return FPropertyRef( ReadMember<void *>( 0 ) );
+        }
+        FPropertyRef GetValueProp() const {
+                return FPropertyRef( ReadMember<void *>( 8 ) );
+        }
+};
+
+class FSetPropertyRef : public FPropertyRef
+{
+      public:
+        static constexpr uint64 StaticCastFlags = CASTCLASS_FSetProperty;
+        using FPropertyRef::FPropertyRef;
+
+        FPropertyRef GetElementProp() const {
+                return FPropertyRef( ReadMember<void *>( 0 ) );
+        }
+};
+
+class FEnumPropertyRef : public FPropertyRef
+{
+      public:
+        static constexpr uint64 StaticCastFlags = CASTCLASS_FEnumProperty;
+        using FPropertyRef::FPropertyRef;
+
+        /** The numeric property the value is stored as. */
+        FPropertyRef GetUnderlyingProp() const {
+                return FPropertyRef( ReadMember<void *>( 0 ) );
+        }
+        UObject *GetEnum() const { return ReadMember<UObject *>( 8 ); }
+};
+
+/**
+ * True if a T can be read from or written to Ref's storage: one element, or the
+ * whole fixed size array. Refs that never resolved a property aren't checked.
+ */
+template <typename T> bool IsPropertySizeCompatible( const FPropertyRef &Ref ) {
+        if ( !Ref.IsValid() || sizeof( T ) == size_t( Ref.GetElementSize() ) ||
+             sizeof( T ) == size_t( Ref.GetSize() ) )
+                return true;
+
+        UE_LOG( LogFortSDK, Warning,
+                "%s is %d bytes, refusing to access it as a %zu byte value",
+                Ref.GetName().c_str(), Ref.GetElementSize(), sizeof( T ) );
+        return false;
+}
+
+/**
+ * Returns Ref as the wrapper T, or an invalid T if the property isn't one.
+ *
+ * if ( auto Array = CastProperty<FArrayPropertyRef>( Ref ); Array.IsValid() )
+ *         ...
+ */
+template <typename T> T CastProperty( const FPropertyRef &Ref ) {
+        return Ref.HasAnyCastFlags( T::StaticCastFlags ) ? T( Ref.Get() ) : T();
+}
+
+namespace PropertyVisitor
+{
+template <EPropertyType Type> struct TRefFor {
+        using Type_ = FPropertyRef;
+};
+#define PROPERTY_REF_FOR( EnumValue, RefType )                                 \
+        template <> struct TRefFor<EPropertyType::EnumValue> {                 \
+                using Type_ = RefType;                                          \
+        };
+PROPERTY_REF_FOR( Bool, FBoolPropertyRef )
+PROPERTY_REF_FOR( Int8, FInt8PropertyRef )
+PROPERTY_REF_FOR( Byte, FBytePropertyRef )
+PROPERTY_REF_FOR( Int16, FInt16PropertyRef )
+PROPERTY_REF_FOR( UInt16, FUInt16PropertyRef )
+PROPERTY_REF_FOR( Int, FIntPropertyRef )
+PROPERTY_REF_FOR( UInt32, FUInt32PropertyRef )
+PROPERTY_REF_FOR( Int64, FInt64PropertyRef )
+PROPERTY_REF_FOR( UInt64, FUInt64PropertyRef )
+PROPERTY_REF_FOR( Float, FFloatPropertyRef )
+PROPERTY_REF_FOR( Double, FDoublePropertyRef )
+PROPERTY_REF_FOR( Name, FNamePropertyRef )
+PROPERTY_REF_FOR( Str, FStrPropertyRef )
+PROPERTY_REF_FOR( Object, FObjectPropertyRef )
+PROPERTY_REF_FOR( WeakObject, FObjectPropertyRef )
+PROPERTY_REF_FOR( LazyObject, FObjectPropertyRef )
+PROPERTY_REF_FOR( SoftObject, FObjectPropertyRef )
+PROPERTY_REF_FOR( Interface, FObjectPropertyRef )
+PROPERTY_REF_FOR( Class, FClassPropertyRef )
+PROPERTY_REF_FOR( SoftClass, FClassPropertyRef )
+PROPERTY_REF_FOR( Struct, FStructPropertyRef )
+PROPERTY_REF_FOR( Array, FArrayPropertyRef )
+PROPERTY_REF_FOR( Map, FMapPropertyRef )
+PROPERTY_REF_FOR( Set, FSetPropertyRef )
+PROPERTY_REF_FOR( Enum, FEnumPropertyRef )
+#undef PROPERTY_REF_FOR
+
+template <typename VisitorType, size_t Index>
+decltype( auto ) Thunk( const FPropertyRef &Ref, VisitorType &Visitor ) {
+        using RefType =
+            typename TRefFor<static_cast<EPropertyType>( Index )>::Type_;
+        return Visitor( RefType( Ref.Get() ) );
+}
+
+template <typename VisitorType, size_t... Is>
+decltype( auto ) Dispatch( const FPropertyRef &Ref, VisitorType &Visitor,
+                           std::index_sequence<Is...> ) {
+        using ResultType =
+            decltype( Thunk<VisitorType, 0>( Ref, Visitor ) );
+        static constexpr ResultType ( *Table[] )( const FPropertyRef &,
+                                                  VisitorType & ) = {
+            &Thunk<VisitorType, Is>... };
+        return Table[static_cast<size_t>( Ref.GetType() )]( Ref, Visitor );
+}
+}
+
+/**
+ * Calls Visitor with Ref converted to its typed wrapper. The wrapper is picked
+ * from a table indexed by EPropertyType, so overloading operator() on the
+ * wrapper types is all a visitor needs; types without a wrapper of their own
+ * (text, delegates, field paths) arrive as a plain FPropertyRef.
+ */
+template <typename VisitorType>
+decltype( auto ) VisitProperty( const FPropertyRef &Ref, VisitorType &&Visitor ) {
+        return PropertyVisitor::Dispatch(
+            Ref, Visitor,
+            std::make_index_sequence<size_t( EPropertyType::Num )>{} );
+}
+}
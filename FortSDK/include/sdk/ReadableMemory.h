@@ -0,0 +1,53 @@
+#pragma once
+
+namespace SDK
+{
+/**
+ * Cache of the process' memory regions for "can I read this" checks that
+ * neither fault nor touch the page. Each VirtualQuery result is kept as a
+ * sorted, non-overlapping interval and looked up by binary search. Entries
+ * go stale after RefreshIntervalMs and the next lookup re-queries just that
+ * region, so a decommit is noticed within that window.
+ */
+class FReadableMemoryMap
+{
+      public:
+        static constexpr uint64_t RefreshIntervalMs = 250;
+
+        static FReadableMemoryMap &Get();
+
+        /** Whether every byte of [Address, Address + Size) is committed and readable. */
+        bool IsReadable( const void *Address, size_t Size );
+
+        /** Drops whatever is cached for the region containing Address. */
+        void Invalidate( const void *Address );
+
+        /**
+         * Copies Size bytes if IsReadable agrees, under SEH so a page freed
+         * since the last refresh fails the read instead of crashing.
+         */
+        bool SafeCopy( void *Dest, const void *Source, size_t Size );
+
+      private:
+        struct FRegion {
+                uintptr_t Start;
+                uintptr_t End;
+                uint64_t ExpiresAt;
+                bool bReadable;
+        };
+
+        /** Index of the region containing Address, INDEX_NONE if nothing is cached for it. */
+        int32_t FindRegion( uintptr_t Address ) const;
+        FRegion QueryRegion( uintptr_t Address ) const;
+        void StoreRegion( const FRegion &Region );
+
+        std::vector<FRegion> Regions;
+        std::shared_mutex Lock;
+};
+
+/** Reads a T from Address if the memory is readable, leaves OutValue alone otherwise. */
+template <typename T> bool SafeRead( const void *Address, T &OutValue ) {
+        static_assert( std::is_trivially_copyable_v<T> );
+        return FReadableMemoryMap::Get().SafeCopy( &OutValue, Address, sizeof( T ) );
+}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+namespace SDK
+{
+/** Information remembered about an Out parameter. */
+struct FOutParmRec {
+        void *Property;
+        uint8 *PropAddr;
+        FOutParmRec *NextOutParm;
+};
+
+/**
+ * Where the FFrame members live on the running engine.
+ * FFrame derives from FOutputDevice and only grew one member before the
+ * fields we touch (MostRecentPropertyContainer in 5.1), everything else is
+ * at the same place on every supported build.
+ */
+struct FFrameLayout {
+        uint32 Node;
+        uint32 Object;
+        uint32 Code;
+        uint32 Locals;
+        uint32 FlowStack;
+        uint32 PreviousFrame;
+        uint32 OutParms;
+        uint32 PropertyChainForCompiledIn;
+        uint32 CurrentNativeFunction;
+        uint32 Size;
+
+        /** Returns the layout for Engine_Version, computed on first use. */
+        static const FFrameLayout &Get();
+};
+
+/**
+ * The FFrame ProcessEvent builds for a native function, without ProcessEvent.
+ * There is no bytecode, so the thunk reads its arguments by walking
+ * PropertyChainForCompiledIn over Locals and finds out params through the
+ * OutParms chain, exactly like it does when called from ProcessEvent.
+ */
+class FNativeFrame
+{
+      public:
+        static constexpr size_t MaxSize = 0xC0;
+
+        FNativeFrame( const UObject *Object, UFunction *Function, uint8 *Locals,
+                      FOutParmRec *OutParms );
+
+        FNativeFrame( const FNativeFrame & ) = delete;
+        FNativeFrame &operator=( const FNativeFrame & ) = delete;
+
+        FORCEINLINE void *Get() { return Data; }
+
+      private:
+        template <typename T> FORCEINLINE void Write( uint32 Offset, T Value ) {
+                *reinterpret_cast<T *>( Data + Offset ) = Value;
+        }
+
+        alignas( 16 ) uint8 Data[MaxSize];
+};
+
+/** Result of BenchmarkNativeInvoke, average nanoseconds per call. */
+struct FNativeInvokeTimings {
+        double ProcessEventNs = 0.0;
+        double NativeInvokeNs = 0.0;
+};
+
+/**
+ * Calls Function on Object Iterations times through ProcessEvent, then the
+ * same number of times through InvokeNative, and logs both averages. The
+ * parameter frame is zeroed once and reused, so only use it on functions
+ * that are fine being called that way (getters, pure functions).
+ */
+FNativeInvokeTimings BenchmarkNativeInvoke( UObject *Object,
+                                            UFunction *Function,
+                                            int32 Iterations = 10000 );
+}
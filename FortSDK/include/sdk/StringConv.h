@@ -0,0 +1,99 @@
+#pragma once
+
+namespace SDK
+{
+/** Worst case UTF-8 size of Length code units. A UTF-16 unit never needs more than 3 bytes, a surrogate pair takes 4. */
+template <typename CharType = wchar_t>
+constexpr size_t GetMaxUtf8Length( size_t Length ) {
+        return Length * ( sizeof( CharType ) == 2 ? 3 : 4 );
+}
+
+/**
+ * Converts UTF-16 to UTF-8 into Dest, which has to hold
+ * GetMaxUtf8Length<CharType>( Length ) bytes. Nothing is allocated and no terminator is
+ * written. Runs of ASCII are converted 16 code units at a time with SSE2, the
+ * rest goes through the scalar encoder; unpaired surrogates become U+FFFD.
+ *
+ * @returns Number of bytes written.
+ */
+template <typename CharType>
+size_t Utf16ToUtf8( const CharType *Source, size_t Length, char *Dest ) {
+        /*wchar_t is only UTF-16 on Windows, wider code units skip the SIMD path*/
+        static_assert( sizeof( CharType ) == 2 || sizeof( CharType ) == 4 );
+
+        char *const DestStart = Dest;
+        size_t i = 0;
+
+        while ( i < Length ) {
+                if constexpr ( sizeof( CharType ) == 2 ) {
+                        const __m128i NonAsciiMask = _mm_set1_epi16( short( 0xFF80 ) );
+                        while ( i + 16 <= Length ) {
+                                const __m128i Low = _mm_loadu_si128(
+                                    reinterpret_cast<const __m128i *>( Source + i ) );
+                                const __m128i High = _mm_loadu_si128(
+                                    reinterpret_cast<const __m128i *>( Source + i + 8 ) );
+                                const __m128i Bits = _mm_and_si128(
+                                    _mm_or_si128( Low, High ), NonAsciiMask );
+                                if ( _mm_movemask_epi8( _mm_cmpeq_epi16(
+                                         Bits, _mm_setzero_si128() ) ) != 0xFFFF )
+                                        break;
+
+                                /*Every unit is < 0x80 so the saturating pack is a plain narrow*/
+                                _mm_storeu_si128( reinterpret_cast<__m128i *>( Dest ),
+                                                  _mm_packus_epi16( Low, High ) );
+                                Dest += 16;
+                                i += 16;
+                        }
+                        if ( i >= Length )
+                                break;
+                }
+
+                uint32_t Code = uint32_t( Source[i++] );
+                if constexpr ( sizeof( CharType ) == 2 ) {
+                        if ( Code >= 0xD800 && Code < 0xE000 ) {
+                                const uint32_t Low = i < Length ? uint32_t( Source[i] ) : 0;
+                                if ( Code < 0xDC00 && Low >= 0xDC00 && Low < 0xE000 ) {
+                                        Code = 0x10000 + ( ( Code - 0xD800 ) << 10 ) +
+                                               ( Low - 0xDC00 );
+                                        i++;
+                                } else {
+                                        Code = 0xFFFD;
+                                }
+                        }
+                } else if ( Code > 0x10FFFF || ( Code >= 0xD800 && Code < 0xE000 ) ) {
+                        Code = 0xFFFD;
+                }
+
+                if ( Code < 0x80 ) {
+                        *Dest++ = char( Code );
+                } else if ( Code < 0x800 ) {
+                        *Dest++ = char( 0xC0 | ( Code >> 6 ) );
+                        *Dest++ = char( 0x80 | ( Code & 0x3F ) );
+                } else if ( Code < 0x10000 ) {
+                        *Dest++ = char( 0xE0 | ( Code >> 12 ) );
+                        *Dest++ = char( 0x80 | ( ( Code >> 6 ) & 0x3F ) );
+                        *Dest++ = char( 0x80 | ( Code & 0x3F ) );
+                } else {
+                        *Dest++ = char( 0xF0 | ( Code >> 18 ) );
+                        *Dest++ = char( 0x80 | ( ( Code >> 12 ) & 0x3F ) );
+                        *Dest++ = char( 0x80 | ( ( Code >> 6 ) & 0x3F ) );
+                        *Dest++ = char( 0x80 | ( Code & 0x3F ) );
+                }
+        }
+
+        return size_t( Dest - DestStart );
+}
+
+/** Appends the UTF-8 form of Source to Out, reusing whatever capacity Out already has. Out can be any std::basic_string<char>, pmr ones included. */
+template <typename CharType, typename Allocator>
+void AppendUtf8( std::basic_string_view<CharType> Source,
+                 std::basic_string<char, std::char_traits<char>, Allocator> &Out ) {
+        const size_t OldSize = Out.size();
+        Out.resize_and_overwrite(
+            OldSize + GetMaxUtf8Length<CharType>( Source.size() ),
+            [&]( char *Buffer, size_t ) {
+                    return OldSize + Utf16ToUtf8( Source.data(), Source.size(),
+                                                  Buffer + OldSize );
+            } );
+}
+}
@@ -22,6 +22,17 @@
                -GetAs: Gets the current address as a type.
                -Get: Gets the current address as an int64.
 
+       -ExecutableMemory:
+           -Functions:
+               -Allocate: Sub-allocates an executable block, optionally within rel32 reach of an address.
+               -Free: Returns a block to its region's free list, with the size it was allocated with.
+
+       -InlineHook:
+           -Transaction:
+               -Add: Decodes the target, builds a relocated trampoline and queues the hook.
+               -Remove: Queues removing an installed hook.
+               -Commit: Suspends the other threads once, writes every queued patch and moves their IPs out of patched code. Writes nothing if a queued hook no longer applies.
+
        -TrampolineHook:
            -Constructors:
                -Default: Takes a pointer pointer to the target function and a pointer to the hook function.
@@ -45,7 +56,14 @@
 #include <intrin.h>
 #include <Windows.h>
 #include <source_location>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <memory>
+#include <algorithm>
 #include <DbgHelp.h>
+#include <TlHelp32.h>
 #pragma comment(lib, "Dbghelp.lib")
 
 #define MemcuryAssert(cond)                                              \
@@ -387,6 +405,228 @@ namespace Memcury
             }
             return bytes;
         }
+
+        // What DecodeInstruction found out about one instruction, offsets are from its first byte
+        struct InstructionInfo
+        {
+            uint8_t Length = 0;
+            uint8_t OpcodeOffset = 0;
+            int8_t RipDispOffset = -1; // disp32 of a [rip+disp32] operand
+            int8_t RelOffset = -1; // rel8/rel32 of a relative branch
+            uint8_t RelSize = 0;
+            bool bFallsThrough = true; // false for ret and unconditional jumps
+        };
+
+        // Length decoder for x64 code, enough to walk and relocate function prologues. Returns false on anything it doesn't know (EVEX, 3DNow!, invalid opcodes).
+        inline auto DecodeInstruction(const uint8_t* code, InstructionInfo& info) -> bool
+        {
+            info = InstructionInfo{};
+            const uint8_t* p = code;
+
+            bool operandSize16 = false;
+            bool addressSize32 = false;
+            for (;; p++)
+            {
+                if (*p == 0x66)
+                    operandSize16 = true;
+                else if (*p == 0x67)
+                    addressSize32 = true;
+                else if (*p != 0xF0 && *p != 0xF2 && *p != 0xF3 && *p != 0x2E && *p != 0x36 && *p != 0x3E && *p != 0x26 && *p != 0x64 && *p != 0x65)
+                    break;
+
+                if (p - code >= 14)
+                    return false;
+            }
+
+            bool rexW = false;
+            if ((*p & 0xF0) == 0x40)
+            {
+                rexW = (*p & 0x08) != 0;
+                p++;
+            }
+
+            info.OpcodeOffset = (uint8_t)(p - code);
+            const uint8_t op = *p++;
+
+            bool hasModRM = false;
+            int immSize = 0;
+            const int immZ = operandSize16 ? 2 : 4;
+
+            if (op == 0xC4 || op == 0xC5)
+            {
+                // VEX, map comes from the prefix, every instruction but vzeroupper/vzeroall has a ModRM
+                uint8_t map = 1;
+                if (op == 0xC4)
+                {
+                    map = *p & 0x1F;
+                    p += 2;
+                }
+                else
+                {
+                    p += 1;
+                }
+
+                const uint8_t vexOp = *p++;
+                if (map < 1 || map > 3)
+                    return false;
+
+                hasModRM = !(map == 1 && vexOp == 0x77);
+                immSize = map == 3 ? 1 : (map == 1 && ((vexOp >= 0x70 && vexOp <= 0x73) || vexOp == 0xC2 || (vexOp >= 0xC4 && vexOp <= 0xC6))) ? 1 : 0;
+            }
+            else if (op == 0x0F)
+            {
+                const uint8_t op2 = *p++;
+                if (op2 == 0x38)
+                {
+                    p++;
+                    hasModRM = true;
+                }
+                else if (op2 == 0x3A)
+                {
+                    p++;
+                    hasModRM = true;
+                    immSize = 1;
+                }
+                else if (op2 >= 0x80 && op2 <= 0x8F)
+                {
+                    info.RelOffset = (int8_t)(p - code);
+                    info.RelSize = 4;
+                    immSize = 4;
+                }
+                else if (op2 == 0x0F)
+                {
+                    return false;
+                }
+                else
+                {
+                    const bool noModRM = (op2 >= 0x05 && op2 <= 0x09) || op2 == 0x0B || (op2 >= 0x30 && op2 <= 0x37) || op2 == 0x77 || (op2 >= 0xA0 && op2 <= 0xA2) || (op2 >= 0xA8 && op2 <= 0xAA) || (op2 >= 0xC8 && op2 <= 0xCF);
+                    hasModRM = !noModRM;
+                    if ((op2 >= 0x70 && op2 <= 0x73) || op2 == 0xA4 || op2 == 0xAC || op2 == 0xBA || op2 == 0xC2 || (op2 >= 0xC4 && op2 <= 0xC6))
+                        immSize = 1;
+                }
+            }
+            else
+            {
+                switch (op)
+                {
+                case 0x06: case 0x07: case 0x0E: case 0x16: case 0x17: case 0x1E: case 0x1F: case 0x27: case 0x2F: case 0x37: case 0x3F:
+                case 0x60: case 0x61: case 0x62: case 0x82: case 0x9A: case 0xD4: case 0xD5: case 0xD6: case 0xEA:
+                    return false;
+                }
+
+                if (op < 0x40)
+                {
+                    hasModRM = (op & 7) < 4;
+                    if ((op & 7) == 4)
+                        immSize = 1;
+                    else if ((op & 7) == 5)
+                        immSize = immZ;
+                }
+                else if (op == 0x63 || (op >= 0x84 && op <= 0x8F) || (op >= 0xD0 && op <= 0xD3) || (op >= 0xD8 && op <= 0xDF) || op == 0xFE || op == 0xFF)
+                {
+                    hasModRM = true;
+                }
+                else if (op == 0x69 || op == 0x81 || op == 0xC7)
+                {
+                    hasModRM = true;
+                    immSize = immZ;
+                }
+                else if (op == 0x6B || op == 0x80 || op == 0x83 || op == 0xC0 || op == 0xC1 || op == 0xC6)
+                {
+                    hasModRM = true;
+                    immSize = 1;
+                }
+                else if (op == 0xF6 || op == 0xF7)
+                {
+                    hasModRM = true;
+                    const uint8_t reg = (*p >> 3) & 7;
+                    if (reg < 2)
+                        immSize = op == 0xF6 ? 1 : immZ;
+                }
+                else if (op == 0x68 || op == 0xA9)
+                {
+                    immSize = immZ;
+                }
+                else if (op == 0x6A || op == 0xA8 || (op >= 0xB0 && op <= 0xB7) || op == 0xCD || (op >= 0xE4 && op <= 0xE7))
+                {
+                    immSize = 1;
+                }
+                else if (op >= 0xB8 && op <= 0xBF)
+                {
+                    immSize = rexW ? 8 : immZ;
+                }
+                else if (op >= 0xA0 && op <= 0xA3)
+                {
+                    immSize = addressSize32 ? 4 : 8;
+                }
+                else if (op == 0xC2 || op == 0xCA)
+                {
+                    immSize = 2;
+                    info.bFallsThrough = false;
+                }
+                else if (op == 0xC8)
+                {
+                    immSize = 3;
+                }
+                else if (op == 0xC3 || op == 0xCB || op == 0xCC)
+                {
+                    info.bFallsThrough = false;
+                }
+                else if ((op >= 0x70 && op <= 0x7F) || (op >= 0xE0 && op <= 0xE3) || op == 0xEB)
+                {
+                    info.RelOffset = (int8_t)(p - code);
+                    info.RelSize = 1;
+                    immSize = 1;
+                    info.bFallsThrough = op != 0xEB;
+                }
+                else if (op == 0xE8 || op == 0xE9)
+                {
+                    info.RelOffset = (int8_t)(p - code);
+                    info.RelSize = 4;
+                    immSize = 4;
+                    info.bFallsThrough = op == 0xE8;
+                }
+            }
+
+            if (hasModRM)
+            {
+                const uint8_t modrm = *p++;
+                const uint8_t mod = modrm >> 6;
+                const uint8_t rm = modrm & 7;
+
+                // jmp r/m64 and jmp far never come back
+                if (op == 0xFF && (((modrm >> 3) & 7) == 4 || ((modrm >> 3) & 7) == 5))
+                    info.bFallsThrough = false;
+
+                if (mod != 3)
+                {
+                    if (rm == 4)
+                    {
+                        const uint8_t sib = *p++;
+                        if (mod == 0 && (sib & 7) == 5)
+                            p += 4;
+                    }
+                    else if (mod == 0 && rm == 5)
+                    {
+                        info.RipDispOffset = (int8_t)(p - code);
+                        p += 4;
+                    }
+
+                    if (mod == 1)
+                        p += 1;
+                    else if (mod == 2)
+                        p += 4;
+                }
+            }
+
+            p += immSize;
+
+            if (p - code > 15)
+                return false;
+
+            info.Length = (uint8_t)(p - code);
+            return true;
+        }
     }
 
     namespace PE
@@ -796,188 +1036,765 @@ namespace Memcury
         }
     };
 
-    /* Bad don't use it tbh... */
-    class TrampolineHook
+    /*
+        Sub-allocates small executable blocks (trampolines, code caves) out of a few
+        regions reserved once, instead of a VirtualAlloc per block. Regions are one
+        allocation granule (64 KiB) each, kept sorted by base, with a free list of
+        byte ranges inside. Passing Near keeps the whole block within rel32 reach of it.
+    */
+    namespace ExecutableMemory
     {
-        void** originalFunctionPtr;
-        PE::Address originalFunction;
-        PE::Address hookFunction;
-        PE::Address allocatedPage;
-        std::vector<uint8_t> restore;
+        constexpr uintptr_t BLOCK_ALIGNMENT = 16;
+        constexpr uintptr_t MAX_REL32_DISTANCE = 0x7FFF0000;
 
-        void PointToCodeIfNot(PE::Address& ptr)
+        struct FreeRange
         {
-            auto bytes = ptr.GetAs<std::uint8_t*>();
+            uint32_t Offset;
+            uint32_t Size;
+        };
 
-            if (ASM::byteIsA(bytes[0], ASM::MNEMONIC::JMP_REL32))
+        struct Region
+        {
+            uintptr_t Base;
+            uintptr_t Size;
+            std::vector<FreeRange> FreeRanges; // Sorted by offset, neighbours never touch
+            std::unordered_map<uint32_t, uint32_t> Blocks; // Offset -> size of every live block, what Free goes by
+        };
+
+        inline std::vector<Region> Regions;
+        inline std::mutex Lock;
+
+        inline auto IsReachable(uintptr_t Start, uintptr_t End, uintptr_t Near) -> bool
+        {
+            if (!Near)
+                return true;
+
+            const uintptr_t Low = Near > MAX_REL32_DISTANCE ? Near - MAX_REL32_DISTANCE : 0;
+            return Start >= Low && End <= Near + MAX_REL32_DISTANCE;
+        }
+
+        inline auto AllocateFromRegion(Region& Region, uintptr_t Size, uintptr_t Near) -> void*
+        {
+            for (auto Itr = Region.FreeRanges.begin(); Itr != Region.FreeRanges.end(); ++Itr)
             {
-                ptr = bytes + 5 + *(int32_t*)&bytes[1];
+                if (Itr->Size < Size)
+                    continue;
+
+                const uintptr_t Start = Region.Base + Itr->Offset;
+                if (!IsReachable(Start, Start + Size, Near))
+                    continue;
+
+                Region.Blocks.emplace(Itr->Offset, (uint32_t)Size);
+
+                Itr->Offset += (uint32_t)Size;
+                Itr->Size -= (uint32_t)Size;
+                if (Itr->Size == 0)
+                    Region.FreeRanges.erase(Itr);
+
+                return (void*)Start;
             }
+
+            return nullptr;
         }
 
-        void* AllocatePageNearAddress(void* targetAddr)
+        inline auto TryReserve(uintptr_t Address, uintptr_t Size) -> void*
         {
-            SYSTEM_INFO sysInfo;
-            GetSystemInfo(&sysInfo);
-            const uint64_t PAGE_SIZE = sysInfo.dwPageSize;
+            return VirtualAlloc((void*)Address, Size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+        }
 
-            uint64_t startAddr = (uint64_t(targetAddr) & ~(PAGE_SIZE - 1)); // round down to nearest page boundary
-            uint64_t minAddr = min(startAddr - 0x7FFFFF00, (uint64_t)sysInfo.lpMinimumApplicationAddress);
-            uint64_t maxAddr = max(startAddr + 0x7FFFFF00, (uint64_t)sysInfo.lpMaximumApplicationAddress);
+        // Hops whole free/used ranges with VirtualQuery, going up from Near and then down
+        inline auto ReserveRegionNear(uintptr_t Near, uintptr_t Size, uintptr_t Granularity) -> void*
+        {
+            if (!Near)
+                return TryReserve(0, Size);
 
-            uint64_t startPage = (startAddr - (startAddr % PAGE_SIZE));
+            SYSTEM_INFO SysInfo;
+            GetSystemInfo(&SysInfo);
+            const uintptr_t MinAddr = (std::max)((uintptr_t)SysInfo.lpMinimumApplicationAddress, Near > MAX_REL32_DISTANCE ? Near - MAX_REL32_DISTANCE : 0);
+            const uintptr_t MaxAddr = (std::min)((uintptr_t)SysInfo.lpMaximumApplicationAddress, Near + MAX_REL32_DISTANCE);
 
-            for (uint64_t pageOffset = 1; pageOffset; pageOffset++)
+            MEMORY_BASIC_INFORMATION Info;
+            for (uintptr_t Addr = (Near + Granularity - 1) & ~(Granularity - 1); Addr + Size <= MaxAddr;)
             {
-                uint64_t byteOffset = pageOffset * PAGE_SIZE;
-                uint64_t highAddr = startPage + byteOffset;
-                uint64_t lowAddr = (startPage > byteOffset) ? startPage - byteOffset : 0;
-
-                bool needsExit = highAddr > maxAddr && lowAddr < minAddr;
+                if (!VirtualQuery((void*)Addr, &Info, sizeof(Info)))
+                    break;
 
-                if (highAddr < maxAddr)
+                const uintptr_t RangeEnd = (uintptr_t)Info.BaseAddress + Info.RegionSize;
+                if (Info.State == MEM_FREE)
                 {
-                    void* outAddr = VirtualAlloc((void*)highAddr, PAGE_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
-                    if (outAddr)
-                        return outAddr;
+                    const uintptr_t Candidate = ((std::max)(Addr, (uintptr_t)Info.BaseAddress) + Granularity - 1) & ~(Granularity - 1);
+                    if (Candidate + Size <= RangeEnd && Candidate + Size <= MaxAddr)
+                    {
+                        if (auto Result = TryReserve(Candidate, Size))
+                            return Result;
+                    }
                 }
 
-                if (lowAddr > minAddr)
-                {
-                    void* outAddr = VirtualAlloc((void*)lowAddr, PAGE_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
-                    if (outAddr != nullptr)
-                        return outAddr;
-                }
+                Addr = (RangeEnd + Granularity - 1) & ~(Granularity - 1);
+            }
 
-                if (needsExit)
-                {
+            for (uintptr_t Addr = Near & ~(Granularity - 1); Addr > MinAddr;)
+            {
+                if (!VirtualQuery((void*)(Addr - 1), &Info, sizeof(Info)))
                     break;
+
+                const uintptr_t RangeBase = (uintptr_t)Info.BaseAddress;
+                if (Info.State == MEM_FREE && Addr >= Size)
+                {
+                    const uintptr_t Candidate = (Addr - Size) & ~(Granularity - 1);
+                    if (Candidate >= RangeBase && Candidate >= MinAddr)
+                    {
+                        if (auto Result = TryReserve(Candidate, Size))
+                            return Result;
+                    }
                 }
+
+                Addr = RangeBase & ~(Granularity - 1);
             }
 
             return nullptr;
         }
 
-        void WriteAbsoluteJump(void* jumpLocation, void* destination)
+        // Returns a block of at least Size bytes, 16 byte aligned and filled with nothing in particular
+        inline auto Allocate(size_t Size, void* Near = nullptr) -> void*
         {
-            uint8_t absJumpInstructions[] = {
-                ASM::Mnemonic("CMOVNS"), 0xBA, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // mov r10, addr
-                0x41, 0xFF, 0xE2 // jmp r10
-            };
+            if (Size == 0)
+                return nullptr;
 
-            auto destination64 = (uint64_t)destination;
-            memcpy(&absJumpInstructions[2], &destination64, sizeof(destination64));
-            memcpy(jumpLocation, absJumpInstructions, sizeof(absJumpInstructions));
+            const uintptr_t AlignedSize = (Size + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+
+            std::lock_guard Guard(Lock);
+
+            for (auto& Region : Regions)
+            {
+                if (auto Block = AllocateFromRegion(Region, AlignedSize, (uintptr_t)Near))
+                    return Block;
+            }
+
+            SYSTEM_INFO SysInfo;
+            GetSystemInfo(&SysInfo);
+            const uintptr_t Granularity = SysInfo.dwAllocationGranularity;
+            const uintptr_t RegionSize = (AlignedSize + Granularity - 1) & ~(Granularity - 1);
+
+            auto Base = (uintptr_t)ReserveRegionNear((uintptr_t)Near, RegionSize, Granularity);
+            if (!Base)
+                return nullptr;
+
+            auto Itr = std::upper_bound(Regions.begin(), Regions.end(), Base, [](uintptr_t Base, const Region& Region)
+                { return Base < Region.Base; });
+            Itr = Regions.insert(Itr, Region{ Base, RegionSize, {}, {} });
+            Itr->Blocks.emplace(0, (uint32_t)AlignedSize);
+
+            if (RegionSize > AlignedSize)
+                Itr->FreeRanges.push_back({ (uint32_t)AlignedSize, (uint32_t)(RegionSize - AlignedSize) });
+
+            return (void*)Base;
         }
 
-        uintptr_t PrepareRestore()
+        // Frees the block with the size Allocate recorded. Blocks that didn't come from Allocate, or were already freed, are ignored; returns whether Block was freed
+        inline auto Free(void* Block) -> bool
         {
-            /*
-                This is not a correct way to do it at all, since not all functions sub from the stack
-                This needs so much more tests, but it works for now.
-            */
+            if (!Block)
+                return false;
 
-            Scanner scanner(originalFunction);
-            scanner.ScanFor({ 0x48, 0x83, 0xEC }); // sub rsp
+            const uintptr_t Address = (uintptr_t)Block;
+
+            std::lock_guard Guard(Lock);
+
+            auto RegionItr = std::upper_bound(Regions.begin(), Regions.end(), Address, [](uintptr_t Address, const Region& Region)
+                { return Address < Region.Base; });
+            if (RegionItr == Regions.begin())
+                return false;
+
+            auto& Region = *--RegionItr;
+            if (Address >= Region.Base + Region.Size)
+                return false;
+
+            const uint32_t Offset = (uint32_t)(Address - Region.Base);
+            auto BlockItr = Region.Blocks.find(Offset);
+            if (BlockItr == Region.Blocks.end())
+                return false;
 
-            auto restoreSize = scanner.Get() - originalFunction.Get();
+            const uint32_t AlignedSize = BlockItr->second;
+            Region.Blocks.erase(BlockItr);
 
-            MemcuryAssert(restoreSize > 0 && restoreSize < 0x100);
+            auto& Ranges = Region.FreeRanges;
+            auto Next = std::upper_bound(Ranges.begin(), Ranges.end(), Offset, [](uint32_t Offset, const FreeRange& Range)
+                { return Offset < Range.Offset; });
 
-            restore.reserve(restoreSize);
-            for (auto i = 0; i < restoreSize; i++)
+            const bool MergePrev = Next != Ranges.begin() && std::prev(Next)->Offset + std::prev(Next)->Size == Offset;
+            const bool MergeNext = Next != Ranges.end() && Offset + AlignedSize == Next->Offset;
+
+            if (MergePrev && MergeNext)
+            {
+                std::prev(Next)->Size += (uint32_t)AlignedSize + Next->Size;
+                Ranges.erase(Next);
+            }
+            else if (MergePrev)
             {
-                restore.push_back(originalFunction.GetAs<uint8_t*>()[i]);
+                std::prev(Next)->Size += (uint32_t)AlignedSize;
+            }
+            else if (MergeNext)
+            {
+                Next->Offset = Offset;
+                Next->Size += (uint32_t)AlignedSize;
+            }
+            else
+            {
+                Ranges.insert(Next, { Offset, (uint32_t)AlignedSize });
             }
 
-            return restoreSize;
+            return true;
         }
+    }
 
-        void WriteRestore()
+    /*
+        Inline hooks that decode what they overwrite. The stolen instructions are
+        copied into a trampoline next to the target with rel32 branches and
+        [rip+disp32] operands re-pointed, so Original still behaves like the target.
+        Hooks are queued on a Transaction and installed together: other threads are
+        suspended once, every patch is written, and any thread sitting inside a
+        patched range is moved to the matching spot in the trampoline (or back out
+        of it when removing).
+    */
+    namespace InlineHook
+    {
+        constexpr size_t SIZE_OF_JMP_REL32 = 5;
+        constexpr size_t SIZE_OF_JMP_ABS64 = 14; // jmp [rip+0] followed by the address
+        constexpr size_t MAX_STOLEN_BYTES = SIZE_OF_JMP_ABS64 + 15;
+
+        struct HOOK
         {
-            auto restorePtr = allocatedPage + ASM::SIZE_OF_JMP_ABSLOUTE_INSTRUCTION + 2;
+            uint8_t* Target = nullptr;
+            void* Detour = nullptr;
+            void** Original = nullptr;
+
+            uint8_t* Trampoline = nullptr; // Start of the block from ExecutableMemory
+            size_t TrampolineSize = 0;
+            uint8_t* Relay = nullptr; // jmp to Detour, when Target can't reach it directly
+            uint8_t* Code = nullptr; // Relocated instructions followed by the jump back
+
+            uint8_t Patch[MAX_STOLEN_BYTES] = {};
+            uint8_t Stolen[MAX_STOLEN_BYTES] = {};
+            uint8_t StolenLength = 0;
+
+            // Instruction boundaries, offset in Target -> offset in Code. The last one is the end of the stolen bytes / the jump back.
+            uint8_t NumBoundaries = 0;
+            uint8_t TargetOffsets[MAX_STOLEN_BYTES] = {};
+            uint8_t CodeOffsets[MAX_STOLEN_BYTES] = {};
+        };
 
-            memcpy(restorePtr.GetAs<void*>(), restore.data(), restore.size());
+        inline std::unordered_map<uintptr_t, std::unique_ptr<HOOK>> Installed;
+        inline std::mutex InstallLock;
 
-            *originalFunctionPtr = restorePtr.GetAs<void*>();
+        inline auto FitsRel32(uintptr_t From, uintptr_t To) -> bool
+        {
+            const int64_t Distance = (int64_t)(To - From);
+            return Distance >= INT32_MIN && Distance <= INT32_MAX;
+        }
 
-            // Write a jump back to where the execution should resume
-            restorePtr.AbsoluteOffset((uint32_t)restore.size());
+        inline auto WriteRel32(uint8_t* At, uint8_t Opcode, uintptr_t To) -> size_t
+        {
+            At[0] = Opcode;
+            *(int32_t*)(At + 1) = (int32_t)(To - ((uintptr_t)At + 5));
+            return 5;
+        }
 
-            auto contuineExecution = originalFunction + restore.size();
+        inline auto WriteAbs64Jump(uint8_t* At, uintptr_t To) -> size_t
+        {
+            At[0] = 0xFF;
+            At[1] = 0x25;
+            *(int32_t*)(At + 2) = 0;
+            *(uint64_t*)(At + 6) = To;
+            return SIZE_OF_JMP_ABS64;
+        }
 
-            WriteAbsoluteJump(restorePtr.GetAs<void*>(), contuineExecution.GetAs<void*>());
+        // 5 bytes when To is in rel32 reach of At, 14 otherwise
+        inline auto WriteJump(uint8_t* At, uintptr_t To) -> size_t
+        {
+            return FitsRel32((uintptr_t)At + 5, To) ? WriteRel32(At, ASM::JMP_REL32, To) : WriteAbs64Jump(At, To);
         }
 
-        auto PrepareJMPInstruction(uint64_t dst)
+        // Copies one decoded instruction from Source to Dest, fixing whatever is relative to rip. 0 if it can't be moved.
+        inline auto RelocateInstruction(const uint8_t* Source, uint8_t* Dest, const ASM::InstructionInfo& Info, const uint8_t* StolenStart, size_t StolenLength) -> size_t
         {
-            uint8_t bytes[5] = { ASM::Mnemonic("JMP_REL32"), 0x0, 0x0, 0x0, 0x0 };
+            const uintptr_t SourceEnd = (uintptr_t)Source + Info.Length;
 
-            const uint64_t relAddr = dst - (originalFunction.Get() + ASM::SIZE_OF_JMP_RELATIVE_INSTRUCTION);
-            memcpy(bytes + 1, &relAddr, 4);
+            if (Info.RelSize)
+            {
+                const uint8_t Op = Source[Info.OpcodeOffset];
+                const int64_t Rel = Info.RelSize == 1 ? *(const int8_t*)(Source + Info.RelOffset) : *(const int32_t*)(Source + Info.RelOffset);
+                const uintptr_t BranchTarget = SourceEnd + Rel;
+
+                // Into the bytes being overwritten, or loop/jrcxz which have no rel32 form
+                if ((BranchTarget > (uintptr_t)StolenStart && BranchTarget < (uintptr_t)StolenStart + StolenLength) || (Op >= 0xE0 && Op <= 0xE3))
+                    return 0;
 
-            return std::move(bytes);
+                if (Op == 0xEB || Op == 0xE9)
+                    return WriteJump(Dest, BranchTarget);
+
+                if (Op == 0xE8)
+                {
+                    if (FitsRel32((uintptr_t)Dest + 5, BranchTarget))
+                        return WriteRel32(Dest, ASM::CALL, BranchTarget);
+
+                    // call [rip+2]; jmp +8; dq BranchTarget
+                    const uint8_t CallAbs[] = { 0xFF, 0x15, 0x02, 0x00, 0x00, 0x00, 0xEB, 0x08 };
+                    memcpy(Dest, CallAbs, sizeof(CallAbs));
+                    *(uint64_t*)(Dest + sizeof(CallAbs)) = BranchTarget;
+                    return sizeof(CallAbs) + 8;
+                }
+
+                // jcc, short (7x) or near (0F 8x)
+                const uint8_t Condition = (Op == 0x0F ? Source[Info.OpcodeOffset + 1] : Op) & 0x0F;
+                if (FitsRel32((uintptr_t)Dest + 6, BranchTarget))
+                {
+                    Dest[0] = 0x0F;
+                    Dest[1] = 0x80 | Condition;
+                    *(int32_t*)(Dest + 2) = (int32_t)(BranchTarget - ((uintptr_t)Dest + 6));
+                    return 6;
+                }
+
+                // Inverted jcc over an absolute jump
+                Dest[0] = 0x70 | (Condition ^ 1);
+                Dest[1] = (uint8_t)SIZE_OF_JMP_ABS64;
+                return 2 + WriteAbs64Jump(Dest + 2, BranchTarget);
+            }
+
+            memcpy(Dest, Source, Info.Length);
+
+            if (Info.RipDispOffset >= 0)
+            {
+                const uintptr_t Operand = SourceEnd + *(const int32_t*)(Source + Info.RipDispOffset);
+                const uintptr_t DestEnd = (uintptr_t)Dest + Info.Length;
+                if (!FitsRel32(DestEnd, Operand))
+                    return 0;
+
+                *(int32_t*)(Dest + Info.RipDispOffset) = (int32_t)(Operand - DestEnd);
+            }
+
+            return Info.Length;
         }
 
-        bool IsHooked()
+        // Decodes Target, picks the patch size and builds the trampoline. Nothing is written to Target yet.
+        inline auto Prepare(HOOK& Hook) -> bool
         {
-            return originalFunction.GetAs<uint8_t*>()[0] == ASM::Mnemonic("JMP_REL32");
+            // Worst case: a relay, up to 14 stolen instructions each relocated to 16 bytes, and a 14 byte jump back
+            Hook.TrampolineSize = SIZE_OF_JMP_ABS64 + SIZE_OF_JMP_ABS64 * 16 + SIZE_OF_JMP_ABS64;
+            Hook.Trampoline = (uint8_t*)ExecutableMemory::Allocate(Hook.TrampolineSize, Hook.Target);
+
+            bool bNearTarget = Hook.Trampoline != nullptr;
+            if (!bNearTarget)
+                Hook.Trampoline = (uint8_t*)ExecutableMemory::Allocate(Hook.TrampolineSize);
+            if (!Hook.Trampoline)
+                return false;
+
+            memset(Hook.Trampoline, ASM::INT3, Hook.TrampolineSize);
+
+            // What Target jumps to, and how many bytes that takes
+            uintptr_t PatchDestination = (uintptr_t)Hook.Detour;
+            size_t PatchLength = SIZE_OF_JMP_REL32;
+            if (!FitsRel32((uintptr_t)Hook.Target + 5, PatchDestination))
+            {
+                if (bNearTarget)
+                {
+                    Hook.Relay = Hook.Trampoline;
+                    WriteAbs64Jump(Hook.Relay, PatchDestination);
+                    PatchDestination = (uintptr_t)Hook.Relay;
+                }
+                else
+                {
+                    PatchLength = SIZE_OF_JMP_ABS64;
+                }
+            }
+
+            Hook.Code = Hook.Trampoline + (Hook.Relay ? SIZE_OF_JMP_ABS64 : 0);
+
+            // Whole instructions until the patch fits
+            size_t Stolen = 0;
+            ASM::InstructionInfo Infos[MAX_STOLEN_BYTES];
+            size_t NumInstructions = 0;
+            while (Stolen < PatchLength)
+            {
+                auto& Info = Infos[NumInstructions];
+                if (!ASM::DecodeInstruction(Hook.Target + Stolen, Info))
+                    break;
+
+                Stolen += Info.Length;
+                NumInstructions++;
+
+                // Past a ret or jmp is someone else's code
+                if (!Info.bFallsThrough && Stolen < PatchLength)
+                    break;
+            }
+
+            if (Stolen < PatchLength || Stolen > MAX_STOLEN_BYTES)
+            {
+                ExecutableMemory::Free(Hook.Trampoline);
+                Hook.Trampoline = nullptr;
+                return false;
+            }
+
+            size_t SourceOffset = 0;
+            size_t CodeOffset = 0;
+            for (size_t i = 0; i < NumInstructions; i++)
+            {
+                Hook.TargetOffsets[i] = (uint8_t)SourceOffset;
+                Hook.CodeOffsets[i] = (uint8_t)CodeOffset;
+
+                const size_t Written = RelocateInstruction(Hook.Target + SourceOffset, Hook.Code + CodeOffset, Infos[i], Hook.Target, Stolen);
+                if (!Written)
+                {
+                    ExecutableMemory::Free(Hook.Trampoline);
+                    Hook.Trampoline = nullptr;
+                    return false;
+                }
+
+                SourceOffset += Infos[i].Length;
+                CodeOffset += Written;
+            }
+            Hook.TargetOffsets[NumInstructions] = (uint8_t)SourceOffset;
+            Hook.CodeOffsets[NumInstructions] = (uint8_t)CodeOffset;
+            Hook.NumBoundaries = (uint8_t)NumInstructions + 1;
+
+            // Only needed if the last stolen instruction falls through
+            if (Infos[NumInstructions - 1].bFallsThrough)
+                WriteJump(Hook.Code + CodeOffset, (uintptr_t)Hook.Target + Stolen);
+
+            Hook.StolenLength = (uint8_t)Stolen;
+            memcpy(Hook.Stolen, Hook.Target, Stolen);
+
+            // Built aside and copied over Target on Commit, so rel32 is computed from Target
+            memset(Hook.Patch, ASM::INT3, Stolen);
+            if (PatchLength == SIZE_OF_JMP_REL32)
+            {
+                Hook.Patch[0] = ASM::JMP_REL32;
+                *(int32_t*)(Hook.Patch + 1) = (int32_t)(PatchDestination - ((uintptr_t)Hook.Target + SIZE_OF_JMP_REL32));
+            }
+            else
+            {
+                WriteAbs64Jump(Hook.Patch, PatchDestination);
+            }
+
+            return true;
         }
 
-    public:
-        TrampolineHook(void** originalFunction, void* hookFunction)
+        // Where a thread at Ip has to continue once Hook goes in (bInstall) or out, Ip if it isn't affected
+        inline auto MapThreadIp(const HOOK& Hook, uintptr_t Ip, bool bInstall) -> uintptr_t
         {
-            this->originalFunctionPtr = originalFunction;
+            for (size_t i = 0; i < Hook.NumBoundaries; i++)
+            {
+                if (bInstall)
+                {
+                    // A thread right at Target will take the new jump, that's the point. The end boundary is past the patch.
+                    if (i > 0 && i + 1 < Hook.NumBoundaries && Ip == (uintptr_t)Hook.Target + Hook.TargetOffsets[i])
+                        return (uintptr_t)Hook.Code + Hook.CodeOffsets[i];
+                }
+                else if (Ip == (uintptr_t)Hook.Code + Hook.CodeOffsets[i])
+                {
+                    return (uintptr_t)Hook.Target + Hook.TargetOffsets[i];
+                }
+            }
 
-            this->originalFunction = *originalFunction;
-            this->hookFunction = hookFunction;
+            if (!bInstall && Hook.Relay && Ip == (uintptr_t)Hook.Relay)
+                return (uintptr_t)Hook.Detour;
 
-            PointToCodeIfNot(this->originalFunction);
-            PointToCodeIfNot(this->hookFunction);
-        };
+            return Ip;
+        }
 
-        bool Commit()
+        inline auto WriteCode(uint8_t* At, const uint8_t* Bytes, size_t Length) -> void
         {
-            auto fnStart = originalFunction.GetAs<void*>();
+            DWORD OldProtect;
+            VirtualProtect(At, Length, PAGE_EXECUTE_READWRITE, &OldProtect);
+            memcpy(At, Bytes, Length);
+            VirtualProtect(At, Length, OldProtect, &OldProtect);
+            FlushInstructionCache(GetCurrentProcess(), At, Length);
+        }
 
-            auto restoreSize = PrepareRestore();
+        class Transaction
+        {
+            struct OPERATION
+            {
+                HOOK* Hook;
+                uintptr_t Target; // Kept apart from Hook, a removal's HOOK may be freed by another Commit before this one runs
+                bool bInstall;
+            };
+
+            std::vector<std::unique_ptr<HOOK>> Pending; // Prepared, not yet installed
+            std::vector<OPERATION> Operations;
 
-            if (!allocatedPage.IsValid())
+            // Handles are reserved up front: a thread suspended inside the heap would deadlock a push_back
+            static auto SuspendOtherThreads(std::vector<HANDLE>& Threads) -> void
             {
-                allocatedPage = AllocatePageNearAddress(fnStart);
+                const DWORD ProcessId = GetCurrentProcessId();
+                const DWORD ThreadId = GetCurrentThreadId();
+
+                HANDLE Snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+                if (Snapshot == INVALID_HANDLE_VALUE)
+                    return;
+
+                THREADENTRY32 Entry{ sizeof(Entry) };
+                size_t NumThreads = 0;
+                for (BOOL bMore = Thread32First(Snapshot, &Entry); bMore; bMore = Thread32Next(Snapshot, &Entry))
+                {
+                    if (Entry.th32OwnerProcessID == ProcessId)
+                        NumThreads++;
+                }
+                Threads.reserve(NumThreads + 32);
+
+                Entry.dwSize = sizeof(Entry);
+                for (BOOL bMore = Thread32First(Snapshot, &Entry); bMore && Threads.size() < Threads.capacity(); bMore = Thread32Next(Snapshot, &Entry))
+                {
+                    if (Entry.th32OwnerProcessID != ProcessId || Entry.th32ThreadID == ThreadId)
+                        continue;
+
+                    HANDLE Thread = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_SET_CONTEXT, FALSE, Entry.th32ThreadID);
+                    if (!Thread)
+                        continue;
+
+                    if (SuspendThread(Thread) == (DWORD)-1)
+                    {
+                        CloseHandle(Thread);
+                        continue;
+                    }
+
+                    Threads.push_back(Thread);
+                }
+
+                CloseHandle(Snapshot);
             }
 
-            memset(allocatedPage.GetAs<void*>(), ASM::MNEMONIC::INT3, 0x1000);
+        public:
+            Transaction() = default;
+            Transaction(const Transaction&) = delete;
+            Transaction& operator=(const Transaction&) = delete;
 
-            WriteAbsoluteJump(allocatedPage.GetAs<void*>(), hookFunction.GetAs<void*>());
+            ~Transaction()
+            {
+                Abort();
+            }
 
-            DWORD oldProtect;
-            VirtualProtect(fnStart, 1024, PAGE_EXECUTE_READWRITE, &oldProtect);
+            // Queues Target -> Detour, Original receives the trampoline on Commit. False if Target can't be hooked.
+            auto Add(void* Target, void* Detour, void** Original = nullptr) -> bool
+            {
+                {
+                    std::lock_guard Guard(InstallLock);
+                    if (Installed.contains((uintptr_t)Target))
+                        return false;
+                }
 
-            auto jmpInstruction = PrepareJMPInstruction(allocatedPage.Get());
+                for (auto& Hook : Pending)
+                {
+                    if (Hook->Target == Target)
+                        return false;
+                }
 
-            WriteRestore();
+                auto Hook = std::make_unique<HOOK>();
+                Hook->Target = (uint8_t*)Target;
+                Hook->Detour = Detour;
+                Hook->Original = Original;
 
-            memset(fnStart, ASM::MNEMONIC::INT3, restoreSize);
-            memcpy(fnStart, jmpInstruction, ASM::SIZE_OF_JMP_RELATIVE_INSTRUCTION);
+                if (!Prepare(*Hook))
+                    return false;
 
-            return true;
+                Operations.push_back({ Hook.get(), (uintptr_t)Target, true });
+                Pending.push_back(std::move(Hook));
+                return true;
+            }
+
+            // Queues removing the hook on Target
+            auto Remove(void* Target) -> bool
+            {
+                std::lock_guard Guard(InstallLock);
+                auto Itr = Installed.find((uintptr_t)Target);
+                if (Itr == Installed.end())
+                    return false;
+
+                for (auto& Operation : Operations)
+                {
+                    if (Operation.Target == (uintptr_t)Target)
+                        return false;
+                }
+
+                Operations.push_back({ Itr->second.get(), (uintptr_t)Target, false });
+                return true;
+            }
+
+            // Drops everything queued, frees the trampolines nobody got to see
+            auto Abort() -> void
+            {
+                for (auto& Hook : Pending)
+                {
+                    ExecutableMemory::Free(Hook->Trampoline);
+                }
+
+                Pending.clear();
+                Operations.clear();
+            }
+
+            // Whether every operation still applies, Add and Remove only checked before the lock was let go
+            auto IsStillValid() const -> bool
+            {
+                for (auto& Operation : Operations)
+                {
+                    auto Itr = Installed.find(Operation.Target);
+                    if (!Operation.bInstall)
+                    {
+                        if (Itr == Installed.end() || Itr->second.get() != Operation.Hook)
+                            return false;
+
+                        continue;
+                    }
+
+                    // Hooked by another Transaction since Add, or the bytes Prepare relocated have changed
+                    if (Itr != Installed.end())
+                        return false;
+
+                    if (memcmp(Operation.Hook->Target, Operation.Hook->Stolen, Operation.Hook->StolenLength) != 0)
+                        return false;
+                }
+
+                return true;
+            }
+
+            // Installs and removes everything queued. If any of it no longer applies nothing is written, the Transaction is aborted and this returns false.
+            auto Commit() -> bool
+            {
+                if (Operations.empty())
+                    return true;
+
+                std::lock_guard Guard(InstallLock);
+
+                if (!IsStillValid())
+                {
+                    Abort();
+                    return false;
+                }
+
+                // Originals go out first, a detour may call through them as soon as it is live
+                for (auto& Operation : Operations)
+                {
+                    if (Operation.bInstall && Operation.Hook->Original)
+                        *Operation.Hook->Original = Operation.Hook->Code;
+                }
+
+                std::vector<HANDLE> Threads;
+                SuspendOtherThreads(Threads);
+
+                for (auto& Operation : Operations)
+                {
+                    auto& Hook = *Operation.Hook;
+                    WriteCode(Hook.Target, Operation.bInstall ? Hook.Patch : Hook.Stolen, Hook.StolenLength);
+                }
+
+                for (HANDLE Thread : Threads)
+                {
+                    CONTEXT Context{};
+                    Context.ContextFlags = CONTEXT_CONTROL;
+                    if (!GetThreadContext(Thread, &Context))
+                        continue;
+
+                    const uintptr_t OldIp = Context.Rip;
+                    for (auto& Operation : Operations)
+                    {
+                        Context.Rip = MapThreadIp(*Operation.Hook, Context.Rip, Operation.bInstall);
+                    }
+
+                    if (Context.Rip != OldIp)
+                        SetThreadContext(Thread, &Context);
+                }
+
+                for (HANDLE Thread : Threads)
+                {
+                    ResumeThread(Thread);
+                    CloseHandle(Thread);
+                }
+
+                for (auto& Operation : Operations)
+                {
+                    auto& Hook = *Operation.Hook;
+                    if (Operation.bInstall)
+                        continue;
+
+                    if (Hook.Original)
+                        *Hook.Original = Hook.Target;
+
+                    ExecutableMemory::Free(Hook.Trampoline);
+                    Installed.erase((uintptr_t)Hook.Target);
+                }
+
+                for (auto& Hook : Pending)
+                {
+                    Installed.emplace((uintptr_t)Hook->Target, std::move(Hook));
+                }
+
+                Pending.clear();
+                Operations.clear();
+                return true;
+            }
+        };
+
+        inline auto IsInstalled(void* Target) -> bool
+        {
+            std::lock_guard Guard(InstallLock);
+            return Installed.contains((uintptr_t)Target);
         }
+    }
 
-        bool Revert()
+    // One InlineHook behind the old interface, use an InlineHook::Transaction to install several at once
+    class TrampolineHook
+    {
+        void** originalFunctionPtr;
+        PE::Address originalFunction;
+        PE::Address hookFunction;
+
+        void PointToCodeIfNot(PE::Address& ptr)
         {
-            auto fnStart = originalFunction.GetAs<void*>();
+            auto bytes = ptr.GetAs<std::uint8_t*>();
 
-            DWORD oldProtect;
-            VirtualProtect(fnStart, 1024, PAGE_EXECUTE_READWRITE, &oldProtect);
+            if (ASM::byteIsA(bytes[0], ASM::MNEMONIC::JMP_REL32))
+            {
+                ptr = bytes + 5 + *(int32_t*)&bytes[1];
+            }
+        }
 
-            memcpy(fnStart, restore.data(), restore.size());
+        bool IsHooked()
+        {
+            return InlineHook::IsInstalled(originalFunction.GetAs<void*>());
+        }
+
+    public:
+        TrampolineHook(void** originalFunction, void* hookFunction)
+        {
+            this->originalFunctionPtr = originalFunction;
 
-            *originalFunctionPtr = originalFunction.GetAs<void*>();
+            this->originalFunction = *originalFunction;
+            this->hookFunction = hookFunction;
 
-            // VirtualFree(allocatedPage.GetAs<void*>(), 0x1000, MEM_RELEASE);
+            PointToCodeIfNot(this->originalFunction);
+            PointToCodeIfNot(this->hookFunction);
+        };
 
-            return true;
+        bool Commit()
+        {
+            InlineHook::Transaction transaction;
+            if (!transaction.Add(originalFunction.GetAs<void*>(), hookFunction.GetAs<void*>(), originalFunctionPtr))
+            {
+                return false;
+            }
+
+            return transaction.Commit();
+        }
+
+        bool Revert()
+        {
+            InlineHook::Transaction transaction;
+            if (!transaction.Remove(originalFunction.GetAs<void*>()))
+            {
+                return false;
+            }
+
+            return transaction.Commit();
         }
 
         auto Toggle()
@@ -993,45 +1810,93 @@ namespace Memcury
 
     namespace VEHHook
     {
-        struct HOOK_INFO
+        constexpr uintptr_t PAGE_MASK = ~uintptr_t(0xFFF);
+
+        // Every hook on a page shares one guard, the page goes back to its old protection with the last one.
+        // Never freed, a thread between its guard trip and single step may still hold one.
+        struct PAGE_INFO
         {
-            void* Original;
-            void* Detour;
+            uintptr_t Base;
+            DWORD OriginalProtection;
+            uint32_t HookCount;
+            std::atomic<bool> bArmed;
+            std::atomic<uint32_t> NumRearming; // Handlers between checking bArmed and putting the guard back
+        };
 
-            HOOK_INFO(void* Original, void* Detour)
-                : Original(Original)
-                , Detour(Detour)
-            {
-            }
+        // What the handler reads, never changed once published. Add and Remove publish a new copy, so the
+        // handler takes no lock and can't wait on a thread that trips a guard while changing hooks.
+        struct HOOK_TABLE
+        {
+            std::unordered_map<uintptr_t, void*> Hooks; // Target -> Detour
+            std::unordered_map<uintptr_t, PAGE_INFO*> Pages; // Page base -> guard, kept once a page was hooked
         };
 
-        inline std::vector<HOOK_INFO> Hooks;
-        inline std::vector<DWORD> HookProtections;
+        inline std::atomic<const HOOK_TABLE*> Table = nullptr;
+        inline std::vector<std::unique_ptr<HOOK_TABLE>> Tables; // Published tables a handler may still be reading
+        inline std::atomic<uint32_t> NumReaders = 0; // Handlers holding a table right now
+        inline std::mutex WriteLock; // Serializes AddHook and RemoveHook, the handler never takes it
         inline HANDLE ExceptionHandler;
 
+        // Page whose guard this thread tripped, re-armed on the single step right after
+        inline thread_local PAGE_INFO* PendingPage = nullptr;
+
         inline long Handler(EXCEPTION_POINTERS* Exception)
         {
             if (Exception->ExceptionRecord->ExceptionCode == STATUS_GUARD_PAGE_VIOLATION)
             {
-                auto Itr = std::find_if(Hooks.begin(), Hooks.end(), [Rip = Exception->ContextRecord->Rip](const HOOK_INFO& Hook)
-                    { return Hook.Original == (void*)Rip; });
-                if (Itr != Hooks.end())
+                const uintptr_t Page = Exception->ExceptionRecord->ExceptionInformation[1] & PAGE_MASK;
+
+                // Counted before the load, so Publish never frees a table this may still read
+                NumReaders++;
+                struct ReaderScope { ~ReaderScope() { NumReaders--; } } Scope;
+
+                const HOOK_TABLE* Current = Table.load();
+                if (!Current)
                 {
-                    Exception->ContextRecord->Rip = (uintptr_t)Itr->Detour;
+                    return EXCEPTION_CONTINUE_SEARCH;
+                }
+
+                auto PageItr = Current->Pages.find(Page);
+                if (PageItr == Current->Pages.end())
+                {
+                    return EXCEPTION_CONTINUE_SEARCH;
                 }
 
+                // A guard RemoveHook is taking down, it's gone now that it tripped
+                if (!PageItr->second->bArmed)
+                {
+                    return EXCEPTION_CONTINUE_EXECUTION;
+                }
+
+                auto Itr = Current->Hooks.find(Exception->ContextRecord->Rip);
+                if (Itr != Current->Hooks.end())
+                {
+                    Exception->ContextRecord->Rip = (uintptr_t)Itr->second;
+                }
+
+                PendingPage = PageItr->second;
                 Exception->ContextRecord->EFlags |= 0x100; // SINGLE_STEP_FLAG
 
                 return EXCEPTION_CONTINUE_EXECUTION;
             }
             else if (Exception->ExceptionRecord->ExceptionCode == STATUS_SINGLE_STEP)
             {
-                // TODO: find a way to only vp the function that about to get executed
-                for (auto& Hook : Hooks)
+                if (!PendingPage)
+                {
+                    return EXCEPTION_CONTINUE_SEARCH;
+                }
+
+                PAGE_INFO* Page = PendingPage;
+                PendingPage = nullptr;
+
+                // RemoveHook waits for NumRearming to drop before restoring the page, so a guard put back here never outlives it
+                Page->NumRearming++;
+                if (Page->bArmed)
                 {
                     DWORD dwOldProtect;
-                    VirtualProtect(Hook.Original, 1, PAGE_EXECUTE_READ | PAGE_GUARD, &dwOldProtect);
+                    VirtualProtect((void*)Page->Base, 1, PAGE_EXECUTE_READ | PAGE_GUARD, &dwOldProtect);
                 }
+                Page->NumRearming--;
 
                 return EXCEPTION_CONTINUE_EXECUTION;
             }
@@ -1048,6 +1913,26 @@ namespace Memcury
             return ExceptionHandler != nullptr;
         }
 
+        // Copies the current table for a change, call with WriteLock held
+        inline auto CopyTable() -> std::unique_ptr<HOOK_TABLE>
+        {
+            const HOOK_TABLE* Current = Table.load();
+            return Current ? std::make_unique<HOOK_TABLE>(*Current) : std::make_unique<HOOK_TABLE>();
+        }
+
+        // Makes NewTable the one the handler reads, call with WriteLock held
+        inline void Publish(std::unique_ptr<HOOK_TABLE> NewTable)
+        {
+            Table.store(NewTable.get());
+
+            // Any handler that starts after this reads NewTable, so with none running the old ones can go
+            if (NumReaders == 0)
+            {
+                Tables.clear();
+            }
+            Tables.push_back(std::move(NewTable));
+        }
+
         inline bool AddHook(void* Target, void* Detour)
         {
             if (ExceptionHandler == nullptr)
@@ -1060,34 +1945,74 @@ namespace Memcury
                 return false;
             }
 
-            if (!VirtualProtect(Target, 1, PAGE_EXECUTE_READ | PAGE_GUARD, &HookProtections.emplace_back()))
+            const uintptr_t Page = (uintptr_t)Target & PAGE_MASK;
+
+            std::lock_guard Guard(WriteLock);
+            auto NewTable = CopyTable();
+            if (NewTable->Hooks.contains((uintptr_t)Target))
             {
-                HookProtections.pop_back();
                 return false;
             }
 
-            Hooks.emplace_back(Target, Detour);
+            PAGE_INFO*& Info = NewTable->Pages[Page];
+            if (!Info)
+            {
+                Info = new PAGE_INFO{ Page, 0, 0, false, 0 };
+            }
+
+            // The guard goes on only once the handler can find the hook it's for
+            NewTable->Hooks.emplace((uintptr_t)Target, Detour);
+            Publish(std::move(NewTable));
+
+            if (Info->HookCount == 0)
+            {
+                Info->bArmed = true;
+
+                DWORD dwOldProtect;
+                if (!VirtualProtect(Target, 1, PAGE_EXECUTE_READ | PAGE_GUARD, &dwOldProtect))
+                {
+                    Info->bArmed = false;
+
+                    auto Restored = CopyTable();
+                    Restored->Hooks.erase((uintptr_t)Target);
+                    Publish(std::move(Restored));
+                    return false;
+                }
+
+                Info->OriginalProtection = dwOldProtect;
+            }
+
+            Info->HookCount++;
             return true;
         }
 
         inline bool RemoveHook(void* Original)
         {
-            auto Itr = std::find_if(Hooks.begin(), Hooks.end(), [Original](const HOOK_INFO& Hook)
-                { return Hook.Original == Original; });
-
-            if (Itr == Hooks.end())
+            std::lock_guard Guard(WriteLock);
+            auto NewTable = CopyTable();
+            if (!NewTable->Hooks.erase((uintptr_t)Original))
             {
                 return false;
             }
 
-            const auto ProtItr = HookProtections.begin() + std::distance(Hooks.begin(), Itr);
-            Hooks.erase(Itr);
+            auto PageItr = NewTable->Pages.find((uintptr_t)Original & PAGE_MASK);
+            PAGE_INFO* Info = PageItr != NewTable->Pages.end() ? PageItr->second : nullptr;
+            Publish(std::move(NewTable));
 
-            DWORD dwOldProtect;
-            bool Ret = VirtualProtect(Original, 1, *ProtItr, &dwOldProtect);
-            HookProtections.erase(ProtItr);
+            if (Info && --Info->HookCount == 0)
+            {
+                // The page stays in the table, a guard that trips before the protection is back still has to be found
+                Info->bArmed = false;
+                while (Info->NumRearming)
+                {
+                    std::this_thread::yield();
+                }
 
-            return false;
+                DWORD dwOldProtect;
+                VirtualProtect(Original, 1, Info->OriginalProtection, &dwOldProtect);
+            }
+
+            return true;
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,275 @@
+#include "pch.h"
+#include "../../include/SDK.h"
+#include <immintrin.h>
+
+/*MSVC emits AVX2 intrinsics anywhere, GCC and clang need the function marked*/
+#if defined( _MSC_VER ) && !defined( __clang__ )
+#define SEARCH_AVX2
+#else
+#define SEARCH_AVX2 __attribute__( ( target( "avx2" ) ) )
+#endif
+
+namespace
+{
+bool DetectAVX2() {
+#if defined( _MSC_VER ) && !defined( __clang__ )
+        int Info[4];
+        __cpuid( Info, 0 );
+        if ( Info[0] < 7 )
+                return false;
+
+        /*The OS has to save the YMM registers too, not just the CPU support them*/
+        __cpuid( Info, 1 );
+        const bool bOSXSave = ( Info[2] & ( 1 << 27 ) ) != 0;
+        if ( !bOSXSave || ( _xgetbv( 0 ) & 0x6 ) != 0x6 )
+                return false;
+
+        __cpuidex( Info, 7, 0 );
+        return ( Info[1] & ( 1 << 5 ) ) != 0;
+#else
+        return __builtin_cpu_supports( "avx2" );
+#endif
+}
+
+/*Lanes of a 32 bit compare where both halves of a 64 bit lane matched*/
+FORCEINLINE __m128i CompareEqual64SSE2( __m128i A, __m128i B ) {
+        const __m128i Equal32 = _mm_cmpeq_epi32( A, B );
+        return _mm_and_si128( Equal32, _mm_shuffle_epi32( Equal32, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+}
+
+/**
+ * Each kernel compares four vectors per step and only works out which lane
+ * hit once the OR of all four says something did. The AVX2 versions hand
+ * their tail to the SSE2 ones, which finish with a scalar loop.
+ */
+int32_t FindFirst32SSE2( const uint32_t *Data, int32_t Num, uint32_t Value ) {
+        const __m128i Needle = _mm_set1_epi32( int( Value ) );
+        int32_t i = 0;
+        for ( ; i + 16 <= Num; i += 16 ) {
+                const __m128i *Block = reinterpret_cast<const __m128i *>( Data + i );
+                const __m128i E0 = _mm_cmpeq_epi32( _mm_loadu_si128( Block + 0 ), Needle );
+                const __m128i E1 = _mm_cmpeq_epi32( _mm_loadu_si128( Block + 1 ), Needle );
+                const __m128i E2 = _mm_cmpeq_epi32( _mm_loadu_si128( Block + 2 ), Needle );
+                const __m128i E3 = _mm_cmpeq_epi32( _mm_loadu_si128( Block + 3 ), Needle );
+                const __m128i Any = _mm_or_si128( _mm_or_si128( E0, E1 ), _mm_or_si128( E2, E3 ) );
+                if ( !_mm_movemask_epi8( Any ) )
+                        continue;
+
+                const uint32_t Mask = uint32_t( _mm_movemask_ps( _mm_castsi128_ps( E0 ) ) ) |
+                                      uint32_t( _mm_movemask_ps( _mm_castsi128_ps( E1 ) ) ) << 4 |
+                                      uint32_t( _mm_movemask_ps( _mm_castsi128_ps( E2 ) ) ) << 8 |
+                                      uint32_t( _mm_movemask_ps( _mm_castsi128_ps( E3 ) ) ) << 12;
+                return i + std::countr_zero( Mask );
+        }
+        for ( ; i < Num; i++ ) {
+                if ( Data[i] == Value )
+                        return i;
+        }
+        return INDEX_NONE;
+}
+
+int32_t FindLast32SSE2( const uint32_t *Data, int32_t Num, uint32_t Value ) {
+        const __m128i Needle = _mm_set1_epi32( int( Value ) );
+        int32_t End = Num;
+        for ( ; End >= 16; End -= 16 ) {
+                const __m128i *Block = reinterpret_cast<const __m128i *>( Data + End - 16 );
+                const __m128i E0 = _mm_cmpeq_epi32( _mm_loadu_si128( Block + 0 ), Needle );
+                const __m128i E1 = _mm_cmpeq_epi32( _mm_loadu_si128( Block + 1 ), Needle );
+                const __m128i E2 = _mm_cmpeq_epi32( _mm_loadu_si128( Block + 2 ), Needle );
+                const __m128i E3 = _mm_cmpeq_epi32( _mm_loadu_si128( Block + 3 ), Needle );
+                const __m128i Any = _mm_or_si128( _mm_or_si128( E0, E1 ), _mm_or_si128( E2, E3 ) );
+                if ( !_mm_movemask_epi8( Any ) )
+                        continue;
+
+                const uint32_t Mask = uint32_t( _mm_movemask_ps( _mm_castsi128_ps( E0 ) ) ) |
+                                      uint32_t( _mm_movemask_ps( _mm_castsi128_ps( E1 ) ) ) << 4 |
+                                      uint32_t( _mm_movemask_ps( _mm_castsi128_ps( E2 ) ) ) << 8 |
+                                      uint32_t( _mm_movemask_ps( _mm_castsi128_ps( E3 ) ) ) << 12;
+                return End - 16 + 31 - std::countl_zero( Mask );
+        }
+        for ( int32_t i = End - 1; i >= 0; i-- ) {
+                if ( Data[i] == Value )
+                        return i;
+        }
+        return INDEX_NONE;
+}
+
+int32_t FindFirst64SSE2( const uint64_t *Data, int32_t Num, uint64_t Value ) {
+        const __m128i Needle = _mm_set1_epi64x( int64_t( Value ) );
+        int32_t i = 0;
+        for ( ; i + 8 <= Num; i += 8 ) {
+                const __m128i *Block = reinterpret_cast<const __m128i *>( Data + i );
+                const __m128i E0 = CompareEqual64SSE2( _mm_loadu_si128( Block + 0 ), Needle );
+                const __m128i E1 = CompareEqual64SSE2( _mm_loadu_si128( Block + 1 ), Needle );
+                const __m128i E2 = CompareEqual64SSE2( _mm_loadu_si128( Block + 2 ), Needle );
+                const __m128i E3 = CompareEqual64SSE2( _mm_loadu_si128( Block + 3 ), Needle );
+                const __m128i Any = _mm_or_si128( _mm_or_si128( E0, E1 ), _mm_or_si128( E2, E3 ) );
+                if ( !_mm_movemask_epi8( Any ) )
+                        continue;
+
+                const uint32_t Mask = uint32_t( _mm_movemask_pd( _mm_castsi128_pd( E0 ) ) ) |
+                                      uint32_t( _mm_movemask_pd( _mm_castsi128_pd( E1 ) ) ) << 2 |
+                                      uint32_t( _mm_movemask_pd( _mm_castsi128_pd( E2 ) ) ) << 4 |
+                                      uint32_t( _mm_movemask_pd( _mm_castsi128_pd( E3 ) ) ) << 6;
+                return i + std::countr_zero( Mask );
+        }
+        for ( ; i < Num; i++ ) {
+                if ( Data[i] == Value )
+                        return i;
+        }
+        return INDEX_NONE;
+}
+
+int32_t FindLast64SSE2( const uint64_t *Data, int32_t Num, uint64_t Value ) {
+        const __m128i Needle = _mm_set1_epi64x( int64_t( Value ) );
+        int32_t End = Num;
+        for ( ; End >= 8; End -= 8 ) {
+                const __m128i *Block = reinterpret_cast<const __m128i *>( Data + End - 8 );
+                const __m128i E0 = CompareEqual64SSE2( _mm_loadu_si128( Block + 0 ), Needle );
+                const __m128i E1 = CompareEqual64SSE2( _mm_loadu_si128( Block + 1 ), Needle );
+                const __m128i E2 = CompareEqual64SSE2( _mm_loadu_si128( Block + 2 ), Needle );
+                const __m128i E3 = CompareEqual64SSE2( _mm_loadu_si128( Block + 3 ), Needle );
+                const __m128i Any = _mm_or_si128( _mm_or_si128( E0, E1 ), _mm_or_si128( E2, E3 ) );
+                if ( !_mm_movemask_epi8( Any ) )
+                        continue;
+
+                const uint32_t Mask = uint32_t( _mm_movemask_pd( _mm_castsi128_pd( E0 ) ) ) |
+                                      uint32_t( _mm_movemask_pd( _mm_castsi128_pd( E1 ) ) ) << 2 |
+                                      uint32_t( _mm_movemask_pd( _mm_castsi128_pd( E2 ) ) ) << 4 |
+                                      uint32_t( _mm_movemask_pd( _mm_castsi128_pd( E3 ) ) ) << 6;
+                return End - 8 + 31 - std::countl_zero( Mask );
+        }
+        for ( int32_t i = End - 1; i >= 0; i-- ) {
+                if ( Data[i] == Value )
+                        return i;
+        }
+        return INDEX_NONE;
+}
+
+SEARCH_AVX2 int32_t FindFirst32AVX2( const uint32_t *Data, int32_t Num, uint32_t Value ) {
+        const __m256i Needle = _mm256_set1_epi32( int( Value ) );
+        int32_t i = 0;
+        for ( ; i + 32 <= Num; i += 32 ) {
+                const __m256i *Block = reinterpret_cast<const __m256i *>( Data + i );
+                const __m256i E0 = _mm256_cmpeq_epi32( _mm256_loadu_si256( Block + 0 ), Needle );
+                const __m256i E1 = _mm256_cmpeq_epi32( _mm256_loadu_si256( Block + 1 ), Needle );
+                const __m256i E2 = _mm256_cmpeq_epi32( _mm256_loadu_si256( Block + 2 ), Needle );
+                const __m256i E3 = _mm256_cmpeq_epi32( _mm256_loadu_si256( Block + 3 ), Needle );
+                const __m256i Any = _mm256_or_si256( _mm256_or_si256( E0, E1 ), _mm256_or_si256( E2, E3 ) );
+                if ( _mm256_testz_si256( Any, Any ) )
+                        continue;
+
+                const uint32_t Mask = uint32_t( _mm256_movemask_ps( _mm256_castsi256_ps( E0 ) ) ) |
+                                      uint32_t( _mm256_movemask_ps( _mm256_castsi256_ps( E1 ) ) ) << 8 |
+                                      uint32_t( _mm256_movemask_ps( _mm256_castsi256_ps( E2 ) ) ) << 16 |
+                                      uint32_t( _mm256_movemask_ps( _mm256_castsi256_ps( E3 ) ) ) << 24;
+                return i + std::countr_zero( Mask );
+        }
+        const int32_t Found = FindFirst32SSE2( Data + i, Num - i, Value );
+        return Found != INDEX_NONE ? i + Found : INDEX_NONE;
+}
+
+SEARCH_AVX2 int32_t FindLast32AVX2( const uint32_t *Data, int32_t Num, uint32_t Value ) {
+        const __m256i Needle = _mm256_set1_epi32( int( Value ) );
+        int32_t End = Num;
+        for ( ; End >= 32; End -= 32 ) {
+                const __m256i *Block = reinterpret_cast<const __m256i *>( Data + End - 32 );
+                const __m256i E0 = _mm256_cmpeq_epi32( _mm256_loadu_si256( Block + 0 ), Needle );
+                const __m256i E1 = _mm256_cmpeq_epi32( _mm256_loadu_si256( Block + 1 ), Needle );
+                const __m256i E2 = _mm256_cmpeq_epi32( _mm256_loadu_si256( Block + 2 ), Needle );
+                const __m256i E3 = _mm256_cmpeq_epi32( _mm256_loadu_si256( Block + 3 ), Needle );
+                const __m256i Any = _mm256_or_si256( _mm256_or_si256( E0, E1 ), _mm256_or_si256( E2, E3 ) );
+                if ( _mm256_testz_si256( Any, Any ) )
+                        continue;
+
+                const uint32_t Mask = uint32_t( _mm256_movemask_ps( _mm256_castsi256_ps( E0 ) ) ) |
+                                      uint32_t( _mm256_movemask_ps( _mm256_castsi256_ps( E1 ) ) ) << 8 |
+                                      uint32_t( _mm256_movemask_ps( _mm256_castsi256_ps( E2 ) ) ) << 16 |
+                                      uint32_t( _mm256_movemask_ps( _mm256_castsi256_ps( E3 ) ) ) << 24;
+                return End - 32 + 31 - std::countl_zero( Mask );
+        }
+        return FindLast32SSE2( Data, End, Value );
+}
+
+SEARCH_AVX2 int32_t FindFirst64AVX2( const uint64_t *Data, int32_t Num, uint64_t Value ) {
+        const __m256i Needle = _mm256_set1_epi64x( int64_t( Value ) );
+        int32_t i = 0;
+        for ( ; i + 16 <= Num; i += 16 ) {
+                const __m256i *Block = reinterpret_cast<const __m256i *>( Data + i );
+                const __m256i E0 = _mm256_cmpeq_epi64( _mm256_loadu_si256( Block + 0 ), Needle );
+                const __m256i E1 = _mm256_cmpeq_epi64( _mm256_loadu_si256( Block + 1 ), Needle );
+                const __m256i E2 = _mm256_cmpeq_epi64( _mm256_loadu_si256( Block + 2 ), Needle );
+                const __m256i E3 = _mm256_cmpeq_epi64( _mm256_loadu_si256( Block + 3 ), Needle );
+                const __m256i Any = _mm256_or_si256( _mm256_or_si256( E0, E1 ), _mm256_or_si256( E2, E3 ) );
+                if ( _mm256_testz_si256( Any, Any ) )
+                        continue;
+
+                const uint32_t Mask = uint32_t( _mm256_movemask_pd( _mm256_castsi256_pd( E0 ) ) ) |
+                                      uint32_t( _mm256_movemask_pd( _mm256_castsi256_pd( E1 ) ) ) << 4 |
+                                      uint32_t( _mm256_movemask_pd( _mm256_castsi256_pd( E2 ) ) ) << 8 |
+                                      uint32_t( _mm256_movemask_pd( _mm256_castsi256_pd( E3 ) ) ) << 12;
+                return i + std::countr_zero( Mask );
+        }
+        const int32_t Found = FindFirst64SSE2( Data + i, Num - i, Value );
+        return Found != INDEX_NONE ? i + Found : INDEX_NONE;
+}
+
+SEARCH_AVX2 int32_t FindLast64AVX2( const uint64_t *Data, int32_t Num, uint64_t Value ) {
+        const __m256i Needle = _mm256_set1_epi64x( int64_t( Value ) );
+        int32_t End = Num;
+        for ( ; End >= 16; End -= 16 ) {
+                const __m256i *Block = reinterpret_cast<const __m256i *>( Data + End - 16 );
+                const __m256i E0 = _mm256_cmpeq_epi64( _mm256_loadu_si256( Block + 0 ), Needle );
+                const __m256i E1 = _mm256_cmpeq_epi64( _mm256_loadu_si256( Block + 1 ), Needle );
+                const __m256i E2 = _mm256_cmpeq_epi64( _mm256_loadu_si256( Block + 2 ), Needle );
+                const __m256i E3 = _mm256_cmpeq_epi64( _mm256_loadu_si256( Block + 3 ), Needle );
+                const __m256i Any = _mm256_or_si256( _mm256_or_si256( E0, E1 ), _mm256_or_si256( E2, E3 ) );
+                if ( _mm256_testz_si256( Any, Any ) )
+                        continue;
+
+                const uint32_t Mask = uint32_t( _mm256_movemask_pd( _mm256_castsi256_pd( E0 ) ) ) |
+                                      uint32_t( _mm256_movemask_pd( _mm256_castsi256_pd( E1 ) ) ) << 4 |
+                                      uint32_t( _mm256_movemask_pd( _mm256_castsi256_pd( E2 ) ) ) << 8 |
+                                      uint32_t( _mm256_movemask_pd( _mm256_castsi256_pd( E3 ) ) ) << 12;
+                return End - 16 + 31 - std::countl_zero( Mask );
+        }
+        return FindLast64SSE2( Data, End, Value );
+}
+
+struct FSearchKernels {
+        decltype( &FindFirst32SSE2 ) FindFirst32;
+        decltype( &FindLast32SSE2 ) FindLast32;
+        decltype( &FindFirst64SSE2 ) FindFirst64;
+        decltype( &FindLast64SSE2 ) FindLast64;
+        bool bAVX2;
+};
+
+const FSearchKernels &GetKernels() {
+        static const FSearchKernels Kernels = [] {
+                if ( DetectAVX2() )
+                        return FSearchKernels{ &FindFirst32AVX2, &FindLast32AVX2,
+                                               &FindFirst64AVX2, &FindLast64AVX2, true };
+                return FSearchKernels{ &FindFirst32SSE2, &FindLast32SSE2,
+                                       &FindFirst64SSE2, &FindLast64SSE2, false };
+        }();
+        return Kernels;
+}
+}
+
+int32_t SDK::ArraySearch::FindFirst32( const uint32_t *Data, int32_t Num, uint32_t Value ) {
+        return GetKernels().FindFirst32( Data, Num, Value );
+}
+
+int32_t SDK::ArraySearch::FindLast32( const uint32_t *Data, int32_t Num, uint32_t Value ) {
+        return GetKernels().FindLast32( Data, Num, Value );
+}
+
+int32_t SDK::ArraySearch::FindFirst64( const uint64_t *Data, int32_t Num, uint64_t Value ) {
+        return GetKernels().FindFirst64( Data, Num, Value );
+}
+
+int32_t SDK::ArraySearch::FindLast64( const uint64_t *Data, int32_t Num, uint64_t Value ) {
+        return GetKernels().FindLast64( Data, Num, Value );
+}
+
+bool SDK::ArraySearch::UsesAVX2() { return GetKernels().bAVX2; }
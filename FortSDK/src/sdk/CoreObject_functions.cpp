@@ -7,28 +7,48 @@ bool SDK::UObjectBase::IsValidLowLevelFast(bool bRecursive) const {
         const int32 AlignmentCheck = MIN_ALIGNMENT - 1;
 
         // Check 'this' pointer before trying to access any of the
-        // Object's members
-        if ( ( this == nullptr ) || *(int*)this < 0x100 ) {
+        // Object's members. Every field below is read through SafeRead,
+        // so memory that is unmapped or unreadable fails the check instead
+        // of faulting. That is all it proves: the GC leaves freed UObjects
+        // in committed pages, so a stale pointer to one still reads fine.
+        if ( ( this == nullptr ) || uintptr_t( this ) < 0x100 ) {
                 UE_LOG_W( LogUObjectBase, Error,
                           TEXT( "\'this\' pointer is invalid." ) );
                 return false;
         }
-        if ( *(int*)this & AlignmentCheck ) {
+        if ( uintptr_t( this ) & AlignmentCheck ) {
                 UE_LOG_W( LogUObjectBase, Error,
                           TEXT( "\'this\' pointer is misaligned." ) );
                 return false;
         }
-        if ( *(void **)this == nullptr ) {
+        void *VTable = nullptr;
+        if ( !SafeRead( this, VTable ) ) {
+                UE_LOG_W( LogUObjectBase, Error,
+                          TEXT( "\'this\' pointer is not readable." ) );
+                return false;
+        }
+        void *FirstVirtual = nullptr;
+        if ( VTable == nullptr || !SafeRead( VTable, FirstVirtual ) ) {
                 UE_LOG_W( LogUObjectBase, Error,
                           TEXT( "Virtual functions table is invalid." ) );
                 return false;
         }
 
-        
+        EObjectFlags Flags = RF_NoFlags;
+        UClass *Class = nullptr;
+        UObject *Outer = nullptr;
+        int32 Index = 0;
+        if ( !SafeRead( &ObjectFlags, Flags ) || !SafeRead( &ClassPrivate, Class ) ||
+             !SafeRead( &OuterPrivate, Outer ) || !SafeRead( &InternalIndex, Index ) ) {
+                UE_LOG_W( LogUObjectBase, Error,
+                          TEXT( "Object members are not readable." ) );
+                return false;
+        }
+
         // These should all be 0.
-        const int CheckZero = ( ObjectFlags & ~RF_AllFlags ) |
-                              ( *(int*)ClassPrivate & AlignmentCheck ) |
-                              ( *(int*)OuterPrivate & AlignmentCheck );
+        const uintptr_t CheckZero = ( Flags & ~RF_AllFlags ) |
+                                  ( uintptr_t( Class ) & AlignmentCheck ) |
+                                  ( uintptr_t( Outer ) & AlignmentCheck );
         if ( !!CheckZero ) {
                 UE_LOG_W( LogUObjectBase, Error,
                           TEXT( "Object flags are invalid or either "
@@ -37,14 +57,14 @@ bool SDK::UObjectBase::IsValidLowLevelFast(bool bRecursive) const {
         }
         // Avoid infinite recursion so call IsValidLowLevelFast on
         // the class object with bRecirsive = false.
-        if ( bRecursive && !ClassPrivate->IsValidLowLevelFast( false ) ) {
+        if ( bRecursive && !Class->IsValidLowLevelFast( false ) ) {
                 UE_LOG_W( LogUObjectBase, Error,
                           TEXT( "Class object failed "
                                 "IsValidLowLevelFast test." ) );
                 return false;
         }
         // Lightweight versions of index checks.
-        if ( InternalIndex <= 0 ) {
+        if ( Index <= 0 ) {
                 UE_LOG_W( LogUObjectBase, Error,
                           TEXT( "Object array index or name index is "
                                 "invalid." ) );
@@ -53,14 +73,109 @@ bool SDK::UObjectBase::IsValidLowLevelFast(bool bRecursive) const {
         return true;
 }
 
+SDK::int32 SDK::FUObjectArray::AllocateSerialNumber( int32 Index ) {
+        FUObjectItem *ObjectItem = IndexToObject( Index );
+        if ( !ObjectItem )
+                return 0;
+        if ( const int32 SerialNumber = ObjectItem->GetSerialNumber() )
+                return SerialNumber;
+        if ( !Offsets::FUObjectArray__AllocateSerialNumber )
+                return 0;
+
+        /*The engine's FUObjectArray, ObjObjects follows the four GC bounds at its start*/
+        auto InternalAllocate = reinterpret_cast<int32 ( * )( void *, int32 )>(
+            Offsets::FUObjectArray__AllocateSerialNumber );
+        return InternalAllocate( reinterpret_cast<uint8 *>( GetObjObjects() ) - 0x10,
+                                 Index );
+}
+
 SDK::FString SDK::FName::ToString() const { 
     static FString& ( *InternalToString )( const FName *, FString & ) =
             decltype( InternalToString )( SDK::Offsets::FName__ToString );
     
-    FString Ret = InternalToString( this, Ret );
+    FString Ret;
+    InternalToString( this, Ret );
     return Ret;
 }
 
+void SDK::FName::AppendString( std::string &Out ) const {
+        ToString().AppendString( Out );
+}
+
+namespace
+{
+struct FWideStringHash {
+        using is_transparent = void;
+
+        size_t operator()( std::wstring_view Name ) const {
+                return std::hash<std::wstring_view>{}( Name );
+        }
+};
+
+/**
+ * Every name built from a string so far, keyed by the exact text.
+ * Only names the engine resolved are kept: a None from FNAME_Find could stop
+ * being None once something adds it.
+ */
+class FNameInternCache
+{
+      public:
+        bool Find( std::wstring_view Name, SDK::FName &OutName ) {
+                std::shared_lock Lock( Mutex );
+                auto Found = Names.find( Name );
+                if ( Found == Names.end() )
+                        return false;
+                OutName = Found->second;
+                return true;
+        }
+
+        void Add( std::wstring_view Name, const SDK::FName &Resolved ) {
+                std::unique_lock Lock( Mutex );
+                Names.try_emplace( std::wstring( Name ), Resolved );
+        }
+
+      private:
+        std::unordered_map<std::wstring, SDK::FName, FWideStringHash, std::equal_to<>>
+            Names;
+        std::shared_mutex Mutex;
+};
+
+FNameInternCache &GetNameInternCache() {
+        static FNameInternCache Cache;
+        return Cache;
+}
+}
+
+SDK::FName::FName( std::wstring_view Name, EFindName FindType )
+    : ComparisonIndex( 0 ), Number( 0 ) {
+        if ( GetNameInternCache().Find( Name, *this ) )
+                return;
+
+        /*Not cached in a static, a name built before Init would pin it to null*/
+        auto InternalConstructor = reinterpret_cast<FName *( * )( FName *, const wchar_t *,
+                                                                  EFindName )>(
+            SDK::Offsets::FName__FName );
+        if ( !InternalConstructor || Name.empty() )
+                return;
+
+        /*The engine wants it terminated*/
+        thread_local std::wstring Terminated;
+        Terminated.assign( Name );
+        InternalConstructor( this, Terminated.c_str(), FindType );
+
+        if ( !IsNone() )
+                GetNameInternCache().Add( Name, *this );
+}
+
+SDK::FName::FName( std::string_view Name, EFindName FindType )
+    : ComparisonIndex( 0 ), Number( 0 ) {
+        thread_local std::wstring Wide;
+        Wide.clear();
+        for ( char Char : Name )
+                Wide.push_back( wchar_t( uint8_t( Char ) ) );
+        *this = FName( std::wstring_view( Wide ), FindType );
+}
+
 SDK::FNativeFuncPtr SDK::UFunction::Func() const {
         return *reinterpret_cast<SDK::FNativeFuncPtr *>(
             __int64( this ) + SDK::Offsets::Members::UFunction__Exec );
@@ -146,22 +261,42 @@ void SDK::UObject::ProcessEvent(UFunction* Function, void* Parms) const {
         return ProcessEvent( this, Function, Parms );
 }
 
+void SDK::UObject::ProcessEventAsNative( UFunction *Function, void *Parms,
+                                         const FFunctionParamsInfo *Info ) const {
+        /*Decided by the flag recorded before anyone forced it, the live one may be another caller's*/
+        if ( !Info || Info->bWasNative ) {
+                ProcessEvent( Function, Parms );
+                return;
+        }
 
-SDK::UFunction* SDK::UObject::GetFunction(const std::string& FunctionName) {
-        UFunction *Found = nullptr;
-        for ( UStruct *Struct = this->GetClass(); Struct;
-              Struct = Struct->GetSuperStruct() ) {
-                SDK::FFunctionInfo FuncInfo =
-                    SDK::PropLibrary->GetFunctionByName(
-                        Struct->GetFName().ToString().ToString(),
-                        FunctionName );
-                if ( FuncInfo.Func ) {
-                        Found = FuncInfo.Func;
-                        break;
-                }
+        /*Joining calls that already forced the flag is one CAS, only the first
+         * caller in and the last one out take the lock and touch FunctionFlags*/
+        std::atomic<int32_t> &NumForcing = Info->NumForcingNative;
+        int32_t Num = NumForcing.load();
+        while ( Num > 0 && !NumForcing.compare_exchange_weak( Num, Num + 1 ) ) {
+        }
+        if ( Num <= 0 ) {
+                std::lock_guard Guard( Info->ForceNativeLock );
+                if ( NumForcing.load() == 0 )
+                        Function->FunctionFlags() |= FUNC_Native;
+                NumForcing.fetch_add( 1 );
+        }
 
+        ProcessEvent( Function, Parms );
 
+        Num = NumForcing.load();
+        while ( Num > 1 && !NumForcing.compare_exchange_weak( Num, Num - 1 ) ) {
+        }
+        if ( Num <= 1 ) {
+                std::lock_guard Guard( Info->ForceNativeLock );
+                if ( NumForcing.fetch_sub( 1 ) == 1 )
+                        Function->FunctionFlags() &= ~uint32( FUNC_Native );
         }
-        
-        return Found;
-}
\ No newline at end of file
+}
+
+
+SDK::UFunction* SDK::UObject::GetFunction(const std::string& FunctionName) {
+        /*The class' function table already includes everything inherited from its SuperStructs*/
+        return SDK::PropLibrary->GetFunctionByName( this->GetClass(), FunctionName )
+            .Func;
+}
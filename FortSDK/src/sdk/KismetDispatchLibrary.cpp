@@ -0,0 +1,110 @@
+#include "pch.h"
+#include "../../include/SDK.h"
+
+SDK::FKismetDispatchLibrary::~FKismetDispatchLibrary() {
+        FQueuedCall *Call = Head.exchange( nullptr, std::memory_order_acquire );
+        while ( Call ) {
+                FQueuedCall *Next = Call->Next;
+                FreeCall( Call );
+                Call = Next;
+        }
+}
+
+SDK::FQueuedCall *SDK::FKismetDispatchLibrary::AllocateCall( UObject *Object,
+                                                             UFunction *Function ) {
+        const FFunctionParamsInfo *ParamsInfo =
+            PropLibrary->GetFunctionParamsInfo( Function );
+        const size_t ParmsSize = ParamsInfo ? ParamsInfo->ParmsSize : 0;
+
+        void *Memory = ::operator new( sizeof( FQueuedCall ) + ParmsSize,
+                                       std::align_val_t( alignof( FQueuedCall ) ) );
+        FQueuedCall *Call = ::new ( Memory ) FQueuedCall();
+        Call->Object = Object;
+        if ( Object ) {
+                Call->ObjectIndex = int32_t( Object->GetUniqueID() );
+                Call->ObjectSerialNumber =
+                    GUObjectArray.AllocateSerialNumber( Call->ObjectIndex );
+        }
+        Call->Function = Function;
+        Call->ParamsInfo = ParamsInfo;
+        std::memset( Call->GetParams(), 0, ParmsSize );
+        return Call;
+}
+
+void SDK::FKismetDispatchLibrary::FreeCall( FQueuedCall *Call ) {
+        Call->~FQueuedCall();
+        ::operator delete( Call, std::align_val_t( alignof( FQueuedCall ) ) );
+}
+
+void SDK::FKismetDispatchLibrary::Submit( FQueuedCall *Call ) {
+        if ( !Call )
+                return;
+
+        FQueuedCall *OldHead = Head.load( std::memory_order_relaxed );
+        do {
+                Call->Next = OldHead;
+        } while ( !Head.compare_exchange_weak( OldHead, Call,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed ) );
+
+        NumQueued.fetch_add( 1, std::memory_order_relaxed );
+}
+
+int32_t SDK::FKismetDispatchLibrary::Drain() {
+        FQueuedCall *List = Head.exchange( nullptr, std::memory_order_acquire );
+        if ( !List )
+                return 0;
+
+        /*Producers push to the front, flip it so calls run in the order they were queued*/
+        FQueuedCall *Ordered = nullptr;
+        while ( List ) {
+                FQueuedCall *Next = List->Next;
+                List->Next = Ordered;
+                Ordered = List;
+                List = Next;
+        }
+
+        int32_t NumRan = 0;
+        while ( Ordered ) {
+                FQueuedCall *Call = Ordered;
+                Ordered = Call->Next;
+
+                /*A GC between Submit and now may have freed the object or given its slot to another one.
+                 * Without a serial number that can't be checked, so the call isn't made at all*/
+                FUObjectItem *Item =
+                    Call->Object ? GUObjectArray.IndexToObject( Call->ObjectIndex )
+                                 : nullptr;
+                if ( Call->ObjectSerialNumber == 0 ) {
+                        Call->bFailed = true;
+                        UE_LOG( LogFortSDK, Warning,
+                                "Dropped a queued call, its object has no "
+                                "serial number to check it still exists" );
+                } else if ( Item && Item->Object == Call->Object &&
+                            Item->GetSerialNumber() == Call->ObjectSerialNumber &&
+                            Call->Function ) {
+                        Call->Object->ProcessEventAsNative( Call->Function,
+                                                            Call->GetParams(),
+                                                            Call->ParamsInfo );
+                } else {
+                        Call->bFailed = true;
+                        UE_LOG( LogFortSDK, Warning,
+                                "Dropped a queued call, its object was "
+                                "destroyed before the queue drained" );
+                }
+
+                if ( Call->OnComplete )
+                        Call->OnComplete( *Call );
+
+                if ( Call->ParamsInfo )
+                        Call->ParamsInfo->DestroyParams( Call->GetParams(),
+                                                         Call->CallerOwnedMask,
+                                                         Call->bOwnsReturnValue,
+                                                         Call->OwnedInputMask );
+                FreeCall( Call );
+                NumRan++;
+        }
+
+        NumQueued.fetch_sub( NumRan, std::memory_order_relaxed );
+        UE_LOG( LogFortSDK, VeryVerbose, "Drained %d queued calls", NumRan );
+        return NumRan;
+}
@@ -0,0 +1,269 @@
+#include "pch.h"
+#include "../../include/SDK.h"
+
+void SDK::FJsonWriter::Flush() {
+        if ( !File || Out.empty() )
+                return;
+        File->write( Out.data(), std::streamsize( Out.size() ) );
+        Out.clear();
+}
+
+void SDK::FJsonWriter::WriteEscaped( std::string_view Value ) {
+        static constexpr char Hex[] = "0123456789abcdef";
+
+        Out += '"';
+        size_t RunStart = 0;
+        for ( size_t i = 0; i < Value.size(); i++ ) {
+                const unsigned char C = Value[i];
+                if ( C >= 0x20 && C != '"' && C != '\\' )
+                        continue;
+
+                /*Copy everything that didn't need escaping in one go*/
+                Out.append( Value.data() + RunStart, i - RunStart );
+                RunStart = i + 1;
+                switch ( C ) {
+                case '"': Out += "\\\""; break;
+                case '\\': Out += "\\\\"; break;
+                case '\n': Out += "\\n"; break;
+                case '\r': Out += "\\r"; break;
+                case '\t': Out += "\\t"; break;
+                default:
+                        Out += "\\u00";
+                        Out += Hex[C >> 4];
+                        Out += Hex[C & 0xF];
+                        break;
+                }
+        }
+        Out.append( Value.data() + RunStart, Value.size() - RunStart );
+        Out += '"';
+}
+
+void SDK::FJsonWriter::WideString( const wchar_t *Value, size_t Length ) {
+        Scratch.clear();
+        AppendUtf8( std::wstring_view( Value, Length ), Scratch );
+        String( Scratch );
+}
+
+void SDK::FJsonWriter::Name( const FName &Value ) {
+        Scratch.clear();
+        Value.AppendString( Scratch );
+        String( Scratch );
+}
+
+namespace
+{
+struct FExportContext {
+        SDK::FKismetExportLibrary &Library;
+        SDK::FJsonWriter &Writer;
+        const SDK::FExportOptions &Options;
+        /*InternalIndex of every object already written in this export*/
+        std::unordered_set<SDK::uint32> Written;
+};
+
+void WriteStruct( FExportContext &Context, SDK::UStruct *Struct, const void *Data,
+                  SDK::UObject *Owner, int32_t Depth );
+
+void WriteReference( FExportContext &Context, SDK::UObject *Object ) {
+        SDK::FJsonWriter &Writer = Context.Writer;
+        Writer.BeginObject();
+        Writer.Key( "$ref" );
+        Writer.Name( Object->GetFName() );
+        Writer.Key( "$index" );
+        Writer.Number( Object->GetUniqueID() );
+        Writer.EndObject();
+}
+
+bool IsOuteredTo( SDK::UObject *Object, SDK::UObject *Outer ) {
+        for ( SDK::UObject *It = Object->GetOuter(); It; It = It->GetOuter() ) {
+                if ( It == Outer )
+                        return true;
+        }
+        return false;
+}
+
+void WriteObject( FExportContext &Context, SDK::UObject *Object,
+                  SDK::UObject *Referencer, int32_t Depth ) {
+        SDK::FJsonWriter &Writer = Context.Writer;
+        if ( !Object ) {
+                Writer.Null();
+                return;
+        }
+
+        const bool bExpand =
+            Depth < Context.Options.MaxDepth &&
+            ( !Referencer || Context.Options.bFollowAllReferences ||
+              IsOuteredTo( Object, Referencer ) ) &&
+            Context.Written.insert( Object->GetUniqueID() ).second;
+        if ( !bExpand ) {
+                WriteReference( Context, Object );
+                return;
+        }
+
+        Writer.BeginObject();
+        Writer.Key( "$name" );
+        Writer.Name( Object->GetFName() );
+        Writer.Key( "$class" );
+        Writer.Name( Object->GetClass()->GetFName() );
+        Writer.Key( "$index" );
+        Writer.Number( Object->GetUniqueID() );
+        WriteStruct( Context, Object->GetClass(), Object, Object, Depth );
+        Writer.EndObject();
+}
+
+/*Writes one value of a property, Data points at the value itself*/
+struct FValueWriter {
+        FExportContext &Context;
+        const void *Data;
+        SDK::UObject *Owner;
+        int32_t Depth;
+
+        /*The wrapper's offset is relative to its container, undo it to read the value at Data*/
+        const void *Container( const SDK::FPropertyRef &Ref ) const {
+                return static_cast<const uint8_t *>( Data ) - Ref.GetOffset();
+        }
+
+        void operator()( const SDK::FPropertyRef & ) const { Context.Writer.Null(); }
+
+        void operator()( const SDK::FBoolPropertyRef &Ref ) const {
+                Context.Writer.Bool( Ref.GetPropertyValue( Container( Ref ) ) );
+        }
+
+        template <typename T, SDK::uint64 Flags>
+        void operator()( const SDK::TPropertyValueRef<T, Flags> & ) const {
+                Context.Writer.Number( *static_cast<const T *>( Data ) );
+        }
+
+        void operator()( const SDK::FNamePropertyRef & ) const {
+                Context.Writer.Name( *static_cast<const SDK::FName *>( Data ) );
+        }
+
+        void operator()( const SDK::FStrPropertyRef & ) const {
+                const SDK::FStringView Str = static_cast<const SDK::FString *>( Data )->View();
+                Context.Writer.WideString( Str.data(), Str.size() );
+        }
+
+        void operator()( const SDK::FEnumPropertyRef &Ref ) const {
+                SDK::FPropertyRef Underlying = Ref.GetUnderlyingProp();
+                SDK::VisitProperty( Underlying, *this );
+        }
+
+        void operator()( const SDK::FObjectPropertyRef &Ref ) const {
+                if ( !Ref.HasAnyCastFlags( SDK::CASTCLASS_FObjectProperty ) ) {
+                        Context.Writer.Null();
+                        return;
+                }
+                WriteObject( Context, *static_cast<SDK::UObject *const *>( Data ), Owner,
+                             Depth + 1 );
+        }
+
+        void operator()( const SDK::FStructPropertyRef &Ref ) const {
+                if ( Depth + 1 >= Context.Options.MaxDepth ) {
+                        Context.Writer.Null();
+                        return;
+                }
+                Context.Writer.BeginObject();
+                WriteStruct( Context, Ref.GetStruct(), Data, Owner, Depth + 1 );
+                Context.Writer.EndObject();
+        }
+
+        void operator()( const SDK::FArrayPropertyRef &Ref ) const {
+                SDK::FPropertyRef Inner = Ref.GetInner();
+                if ( !Inner.IsValid() ) {
+                        Context.Writer.Null();
+                        return;
+                }
+                const auto &Array = *static_cast<const SDK::TArray<uint8_t> *>( Data );
+
+                Context.Writer.BeginArray();
+                for ( const uint8_t &Element : Array.GetView( Inner.GetElementSize() ) ) {
+                        FValueWriter ElementWriter{ Context, &Element, Owner, Depth };
+                        SDK::VisitProperty( Inner, ElementWriter );
+                }
+                Context.Writer.EndArray();
+        }
+};
+
+/*Owner is the object the struct lives in, object references are expanded if they're outered to it*/
+void WriteStruct( FExportContext &Context, SDK::UStruct *Struct, const void *Data,
+                  SDK::UObject *Owner, int32_t Depth ) {
+        for ( const SDK::FPropertyInfo *PropInfo :
+              Context.Library.GetSortedProperties( Struct ) ) {
+                const SDK::FPropertyRef &Ref = PropInfo->Ref;
+                Context.Writer.Key( PropInfo->PropName );
+
+                if ( Ref.GetArrayDim() > 1 )
+                        Context.Writer.BeginArray();
+                for ( int32_t i = 0; i < Ref.GetArrayDim(); i++ ) {
+                        FValueWriter Value{ Context, Ref.ContainerPtrToValuePtr( Data, i ),
+                                            Owner, Depth };
+                        SDK::VisitProperty( Ref, Value );
+                }
+                if ( Ref.GetArrayDim() > 1 )
+                        Context.Writer.EndArray();
+        }
+}
+}
+
+const std::vector<const SDK::FPropertyInfo *> &
+SDK::FKismetExportLibrary::GetSortedProperties( UStruct *Struct ) {
+        {
+                std::shared_lock Lock( SortedPropertiesLock );
+                auto Found = SortedProperties.find( Struct );
+                if ( Found != SortedProperties.end() )
+                        return Found->second;
+        }
+
+        std::vector<const FPropertyInfo *> Props;
+        if ( const FStructInfo *StructInfo = PropLibrary->GetStructInfo( Struct ) ) {
+                for ( const auto &[Name, PropInfo] : StructInfo->Properties )
+                        Props.push_back( &PropInfo );
+        }
+        std::sort( Props.begin(), Props.end(),
+                   []( const FPropertyInfo *A, const FPropertyInfo *B ) {
+                           return A->Offset < B->Offset;
+                   } );
+
+        std::unique_lock Lock( SortedPropertiesLock );
+        return SortedProperties.try_emplace( Struct, std::move( Props ) ).first->second;
+}
+
+void SDK::FKismetExportLibrary::ExportObject( UObject *Object, std::string &Out,
+                                              const FExportOptions &Options ) {
+        FJsonWriter Writer( Out );
+        FExportContext Context{ *this, Writer, Options, {} };
+        WriteObject( Context, Object, nullptr, 0 );
+}
+
+void SDK::FKismetExportLibrary::ExportObjects( const std::vector<UObject *> &Objects,
+                                               std::string &Out,
+                                               const FExportOptions &Options ) {
+        FJsonWriter Writer( Out );
+        FExportContext Context{ *this, Writer, Options, {} };
+        Writer.BeginArray();
+        for ( UObject *Object : Objects )
+                WriteObject( Context, Object, nullptr, 0 );
+        Writer.EndArray();
+}
+
+bool SDK::FKismetExportLibrary::ExportObjectsToFile(
+    const std::vector<UObject *> &Objects, const std::string &Path,
+    const FExportOptions &Options ) {
+        std::ofstream File( Path, std::ios::binary | std::ios::trunc );
+        if ( !File ) {
+                UE_LOG( LogFortSDK, Warning, "Failed to open %s for export",
+                        Path.c_str() );
+                return false;
+        }
+
+        std::string Buffer;
+        Buffer.reserve( FJsonWriter::FlushThreshold * 2 );
+        {
+                FJsonWriter Writer( Buffer, &File );
+                FExportContext Context{ *this, Writer, Options, {} };
+                Writer.BeginArray();
+                for ( UObject *Object : Objects )
+                        WriteObject( Context, Object, nullptr, 0 );
+                Writer.EndArray();
+        }
+        return bool( File );
+}
@@ -75,14 +75,18 @@ SDK::FKismetMemoryLibrary::FKismetMemoryLibrary(uint64_t Address) {
 }
 
 void SDK::FKismetMemoryLibrary::ResizeVirtualMemory(int32_t OldSize, int32_t NewSize) {
-    void* NewData = VirtualAlloc( nullptr, NewSize, MEM_COMMIT | MEM_RESERVE, 
-        PAGE_EXECUTE_READWRITE );
+        /*Kept near the old block so rel32 references into it still reach*/
+        void *NewData = Memcury::ExecutableMemory::Allocate( NewSize, this->m_data );
         if ( NewData == nullptr ) {
             this->m_status = 0;
-            printf( "Failed to allocate memory via VirtualAlloc" );
+            printf( "Failed to allocate executable memory" );
             return;
         }
-        memcpy( NewData, this->m_data, OldSize );
+        if ( this->m_data )
+                memcpy( NewData, this->m_data, ( std::min )( OldSize, NewSize ) );
+
+        /*Only frees it if it came from the pool, a caller's own buffer stays theirs*/
+        Memcury::ExecutableMemory::Free( this->m_data );
         this->m_data = NewData;
 }
 
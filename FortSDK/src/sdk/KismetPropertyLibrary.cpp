@@ -21,182 +21,497 @@ int SDK::FKismetPropertyManager::GetOffset() {
         return 0;
 }
 
-SDK::FPropertyInfo SDK::FKismetPropertyLibrary::GetPropertyByName(const std::string& ClassName,
-    const std::string& PropName)
-{
-        auto Found = std::find_if(AllPropertyInfo.begin(), AllPropertyInfo.end(), [&](const FPropertyInfo& PropInfo ) {
-                    return PropInfo.ClassName == ClassName &&
-                           PropInfo.PropName == PropName;
-        } );
-
-
-        if (Found != AllPropertyInfo.end()) {
-                return *Found;
+int SDK::FKismetPropertyManager::GetElementSize() {
+        if ( !Prop )
+                return 0;
+        if ( UEChanges::bUsesFPropertySystem ) {
+                if ( UEChanges::bUsesUE5FProp ) {
+                        SDK::FProperty500 *Prop =
+                            static_cast<SDK::FProperty500 *>( this->Prop );
+                        return Prop->ElementSize();
+                }
+                SDK::FProperty *Prop =
+                    static_cast<SDK::FProperty *>( this->Prop );
+                return Prop->ElementSize;
         } else {
-                UE_LOG( LogFortSDK, VeryVerbose,
-                        "Failed to get Prop by Pred" );
+                SDK::UProperty *Prop =
+                    static_cast<SDK::UProperty *>( this->Prop );
+                return Prop->ElementSize;
         }
+}
 
-        FPropertyInfo Info{};
-        Info.ClassName = ClassName;
-        Info.PropName = PropName;
-        Info.Offset = -1;
+int SDK::FKismetPropertyManager::GetArrayDim() {
+        if ( !Prop )
+                return 0;
+        if ( UEChanges::bUsesFPropertySystem ) {
+                if ( UEChanges::bUsesUE5FProp ) {
+                        SDK::FProperty500 *Prop =
+                            static_cast<SDK::FProperty500 *>( this->Prop );
+                        return Prop->ArrayDim();
+                }
+                SDK::FProperty *Prop =
+                    static_cast<SDK::FProperty *>( this->Prop );
+                return Prop->ArrayDim;
+        } else {
+                SDK::UProperty *Prop =
+                    static_cast<SDK::UProperty *>( this->Prop );
+                return Prop->ArrayDim;
+        }
+}
 
-        void *result = nullptr;
-        UClass *Class = StaticClassImpl( ClassName.c_str() );
+SDK::EPropertyFlags SDK::FKismetPropertyManager::GetPropertyFlags() {
+        if ( !Prop )
+                return CPF_None;
+        if ( UEChanges::bUsesFPropertySystem ) {
+                if ( UEChanges::bUsesUE5FProp ) {
+                        SDK::FProperty500 *Prop =
+                            static_cast<SDK::FProperty500 *>( this->Prop );
+                        return Prop->PropertyFlags();
+                }
+                SDK::FProperty *Prop =
+                    static_cast<SDK::FProperty *>( this->Prop );
+                return Prop->PropertyFlags;
+        } else {
+                SDK::UProperty *Prop =
+                    static_cast<SDK::UProperty *>( this->Prop );
+                return Prop->PropertyFlags;
+        }
+}
 
+std::string SDK::FKismetPropertyManager::GetName() {
+        if ( !Prop )
+                return std::string();
+        if ( UEChanges::bUsesFPropertySystem ) {
+                SDK::FField *Field = static_cast<SDK::FField *>( this->Prop );
+                return Field->NamePrivate.ToString().ToString();
+        } else {
+                SDK::UProperty *Prop =
+                    static_cast<SDK::UProperty *>( this->Prop );
+                return Prop->GetFName().ToString().ToString();
+        }
+}
 
+std::string SDK::FKismetPropertyManager::GetClassName() {
+        if ( !Prop )
+                return std::string();
         if ( UEChanges::bUsesFPropertySystem ) {
-                if ( UEChanges::bUsesUE5FProp ) {
+                SDK::FField *Field = static_cast<SDK::FField *>( this->Prop );
+                return Field->ClassPrivate->Name.ToString().ToString();
+        } else {
+                SDK::UProperty *Prop =
+                    static_cast<SDK::UProperty *>( this->Prop );
+                return Prop->GetClass()->GetFName().ToString().ToString();
+        }
+}
+
+/*Visits Struct's DestructorLink chain, the properties that need more than a free of the container*/
+template <typename FuncType>
+static void ForEachDestructorLinkProperty( SDK::UStruct *Struct, FuncType Func ) {
+        if ( SDK::UEChanges::bUsesFPropertySystem ) {
+                if ( SDK::UEChanges::bUsesUE5FProp ) {
                         SDK::FProperty500 *Prop = nullptr;
-                        Class->GetPropertyLink( &Prop );
-                        if ( !Prop ) {
-                                UE_LOG( LogFortSDK, Warning,
-                                        "Failed to get valid PropertyLink from "
-                                        "class: %s",
-                                        ClassName.c_str() );
-                                return Info;
-                        }
-                        for ( Prop; Prop = Prop->PropertyLinkNext; ) {
-                                if ( Prop->NamePrivate.ToString().ToString() ==
-                                     PropName ) {
-                                        result = Prop;
-                                        break;
-                                }
-                        }
+                        Struct->GetDestructorLink( &Prop );
+                        for ( ; Prop; Prop = Prop->DestructorLinkNext )
+                                Func( static_cast<void *>( Prop ) );
                 } else {
-                        FProperty *Prop = nullptr;
-                        Class->GetPropertyLink( &Prop );
-                        if ( !Prop ) {
-                                UE_LOG( LogFortSDK, Warning,
-                                        "Failed to get valid PropertyLink from "
-                                        "class: %s",
-                                        ClassName.c_str() );
-                                return Info;
-                        }
-                        for ( Prop; Prop = Prop->PropertyLinkNext; ) {
-                                if ( Prop->NamePrivate.ToString().ToString() ==
-                                     PropName ) {
-                                        result = Prop;
-                                        break;
-                                }
-                        }
+                        SDK::FProperty *Prop = nullptr;
+                        Struct->GetDestructorLink( &Prop );
+                        for ( ; Prop; Prop = Prop->DestructorLinkNext )
+                                Func( static_cast<void *>( Prop ) );
                 }
         } else {
-                UProperty *Prop = nullptr;
-                Class->GetPropertyLink( &Prop );
-                if ( !Prop ) {
-                        UE_LOG(
-                            LogFortSDK, Warning,
-                            "Failed to get valid PropertyLink from class: %s",
-                            ClassName.c_str() );
-                        return Info;
-                }
-                for ( Prop; Prop = Prop->PropertyLinkNext; ) {
-                        if ( Prop->GetFName().ToString().ToString() ==
-                             PropName ) {
-                                result = Prop;
-                                break;
-                        }
+                SDK::UProperty *Prop = nullptr;
+                Struct->GetDestructorLink( &Prop );
+                for ( ; Prop; Prop = Prop->DestructorLinkNext )
+                        Func( static_cast<void *>( Prop ) );
+        }
+}
+
+/*Visits Struct's PropertyLink chain, which already includes inherited properties*/
+template <typename FuncType>
+static void ForEachLinkedProperty( SDK::UStruct *Struct, FuncType Func ) {
+        if ( SDK::UEChanges::bUsesFPropertySystem ) {
+                if ( SDK::UEChanges::bUsesUE5FProp ) {
+                        SDK::FProperty500 *Prop = nullptr;
+                        Struct->GetPropertyLink( &Prop );
+                        for ( ; Prop; Prop = Prop->PropertyLinkNext )
+                                Func( static_cast<void *>( Prop ) );
+                } else {
+                        SDK::FProperty *Prop = nullptr;
+                        Struct->GetPropertyLink( &Prop );
+                        for ( ; Prop; Prop = Prop->PropertyLinkNext )
+                                Func( static_cast<void *>( Prop ) );
                 }
+        } else {
+                SDK::UProperty *Prop = nullptr;
+                Struct->GetPropertyLink( &Prop );
+                for ( ; Prop; Prop = Prop->PropertyLinkNext )
+                        Func( static_cast<void *>( Prop ) );
         }
+}
 
-        if ( !result ) {
-                UE_LOG( LogFortSDK, VeryVerbose,
-                        "Failed to find %s from class %s with PropertyLink",
-                        PropName.c_str(), ClassName.c_str() );
+/*Visits the functions declared directly on Struct, UFunctions always live in Children*/
+template <typename FuncType>
+static void ForEachOwnFunction( SDK::UStruct *Struct, FuncType Func ) {
+        for ( SDK::UField *Next = Struct->GetChildren(); Next;
+              Next = Next->Next ) {
+                if ( !Next->GetClass() || !Next->IsA<SDK::UFunction>() )
+                        continue;
+                Func( reinterpret_cast<SDK::UFunction *>( Next ) );
         }
+}
 
+/*Visits the properties declared directly on Struct, inherited ones are picked up from the SuperStruct's info*/
+template <typename FuncType>
+static void ForEachOwnProperty( SDK::UStruct *Struct, FuncType Func ) {
         const static bool bUseChildProperties =
             SDK::Offsets::Members::UStruct__ChildProperties != -1;
         if ( bUseChildProperties ) /*ChildrenProperties are nice because all of
                                       these are properties*/
         {
-                for ( FField *Next = Class->GetChildrenProperties(); Next;
+                for ( SDK::FField *Next = Struct->GetChildrenProperties(); Next;
                       Next = Next->Next ) {
-                        FProperty *NextProp = reinterpret_cast<FProperty *>(
-                            Next ); /*Should be FProperty on the same build that
-                                       has ChildrenProperties im pretty sure*/
-
-                        if ( NextProp->NamePrivate.ToString().ToString() ==
-                             PropName ) {
-                                result = NextProp;
-                                break;
-                        }
+                        Func( static_cast<void *>( Next ) );
                 }
         } else {
                 /*I think its safe to only use UProperty here, but we should
                  * check this at some point*/
-                for ( UField *Next = Class->GetChildren(); Next;
+                for ( SDK::UField *Next = Struct->GetChildren(); Next;
                       Next = Next->Next ) {
                         if ( !Next->GetClass() )
                                 continue;
-                        if ( Next->IsA<UFunction>() )
+                        if ( Next->IsA<SDK::UFunction>() )
                                 continue;
-                        UProperty *NextProp =
-                            reinterpret_cast<UProperty *>( Next );
-                        if ( NextProp->GetFName().ToString().ToString() ==
-                             PropName ) {
-                                result = NextProp;
-                                break;
-                        }
+                        Func( static_cast<void *>( Next ) );
                 }
         }
+}
 
-        if ( !result ) {
-                UE_LOG( LogFortSDK, Fatal,
-                        "Failed to find %s from class %s entirely.",
-                        PropName.c_str(), ClassName.c_str() );
+/*Returned by reference on a miss, Offset is -1 so the existing checks keep working*/
+static const SDK::FPropertyInfo &GetInvalidPropertyInfo() {
+        static const SDK::FPropertyInfo InvalidInfo = [] {
+                SDK::FPropertyInfo Info{};
+                Info.Prop = nullptr;
+                Info.Offset = -1;
                 return Info;
-        }
+        }();
+        return InvalidInfo;
+}
 
-        Info.Prop = result;
-        std::unique_ptr<FKismetPropertyManager> Manager =
-            std::make_unique<FKismetPropertyManager>( Info.Prop );
+static const SDK::FFunctionInfo &GetInvalidFunctionInfo() {
+        static const SDK::FFunctionInfo InvalidInfo{ nullptr, std::string() };
+        return InvalidInfo;
+}
 
-        Info.Offset = Manager->GetOffset();
+const SDK::FStructInfo *
+SDK::FKismetPropertyLibrary::GetStructInfo( UStruct *Struct ) {
+        if ( !Struct )
+                return nullptr;
 
-        AllPropertyInfo.push_back( Info );
-        return Info;
-}
+        {
+                std::shared_lock Lock( StructInfoLock );
+                auto Found = AllStructInfo.find( Struct );
+                if ( Found != AllStructInfo.end() )
+                        return Found->second.get();
+        }
 
-SDK::FFunctionInfo SDK::FKismetPropertyLibrary::GetFunctionByName(const std::string& ClassName,
-    const std::string& FunctionName)
-{
-        auto Found = std::find_if(AllFunctionInfo.begin(), AllFunctionInfo.end(), [&]( const FFunctionInfo& FunctionInfo ) {
-                    return FunctionInfo.ClassName ==
-                               ClassName && FunctionInfo.Func->GetFName()
-                                                    .ToString()
-                                                    .ToString() == FunctionName;
-        });
+        /*Parent first, so the chain is only ever walked once per struct*/
+        const FStructInfo *SuperInfo =
+            GetStructInfo( Struct->GetSuperStruct() );
 
-        if ( Found != AllFunctionInfo.end() ) {
-                return *Found;
+        std::unique_ptr<FStructInfo> Info = std::make_unique<FStructInfo>();
+        Info->Struct = Struct;
+        if ( SuperInfo ) {
+                Info->Properties = SuperInfo->Properties;
+                Info->Functions = SuperInfo->Functions;
         }
 
-        FFunctionInfo FunctionInfo{};
-        FunctionInfo.ClassName = ClassName;
+        const std::string StructName = Struct->GetFName().ToString().ToString();
+
+        ForEachOwnProperty( Struct, [&]( void *Prop ) {
+                FKismetPropertyManager Manager{ Prop };
+
+                FPropertyInfo PropInfo{};
+                PropInfo.Prop = Prop;
+                PropInfo.Offset = Manager.GetOffset();
+                PropInfo.ClassName = StructName;
+                PropInfo.PropName = Manager.GetName();
+                PropInfo.Ref = FPropertyRef( Prop );
+
+                /*Shadowing a parent member keeps the most derived one*/
+                Info->Properties.insert_or_assign( PropInfo.PropName, PropInfo );
+        } );
+
+        /*Names are converted once here, lookups never call ToString again*/
+        ForEachOwnFunction( Struct, [&]( UFunction *Function ) {
+                FFunctionInfo FunctionInfo{ Function, StructName };
+                Info->Functions.insert_or_assign(
+                    Function->GetFName().ToString().ToString(), FunctionInfo );
+        } );
+
+        UE_LOG( LogFortSDK, VeryVerbose,
+                "Built reflection maps for %s with %zu properties and %zu "
+                "functions",
+                StructName.c_str(), Info->Properties.size(),
+                Info->Functions.size() );
+
+        std::unique_lock Lock( StructInfoLock );
+        auto Result = AllStructInfo.try_emplace( Struct, std::move( Info ) );
+        return Result.first->second.get();
+}
 
-        UFunction *result = nullptr;
+const SDK::FPropertyInfo &
+SDK::FKismetPropertyLibrary::GetPropertyByName( const std::string &ClassName,
+                                                const std::string &PropName ) {
         UClass *Class = StaticClassImpl( ClassName.c_str() );
-        for (UField* Next = Class->GetChildren(); Next; Next = Next->Next)
-        {
-                if ( !Next->IsA<UFunction>() )
-                        continue;
-                if ( Next->GetFName().ToString().ToString() == FunctionName ) {
-                        result = reinterpret_cast<UFunction *>( Next );
-                        break;
-                }
+        if ( !Class ) {
+                UE_LOG( LogFortSDK, Warning,
+                        "Failed to find %s, class %s does not exist.",
+                        PropName.c_str(), ClassName.c_str() );
+                return GetInvalidPropertyInfo();
         }
-        if ( !result ) {
+
+        return GetPropertyByName( Class, PropName );
+}
+
+const SDK::FPropertyInfo &
+SDK::FKismetPropertyLibrary::GetPropertyByName( UStruct *Struct,
+                                                std::string_view PropName ) {
+        const FStructInfo *Info = GetStructInfo( Struct );
+        if ( !Info )
+                return GetInvalidPropertyInfo();
+
+        auto Found = Info->Properties.find( PropName );
+        if ( Found != Info->Properties.end() )
+                return Found->second;
+
+        UE_LOG( LogFortSDK, Warning,
+                "Failed to find %.*s on %s or any of its super structs.",
+                static_cast<int>( PropName.size() ), PropName.data(),
+                Struct->GetFName().ToString().ToString().c_str() );
+        return GetInvalidPropertyInfo();
+}
+
+const SDK::FFunctionInfo &
+SDK::FKismetPropertyLibrary::GetFunctionByName( const std::string &ClassName,
+                                                const std::string &FunctionName ) {
+        UClass *Class = StaticClassImpl( ClassName.c_str() );
+        if ( !Class ) {
                 UE_LOG( LogFortSDK, VeryVerbose,
-                        "Failed to find function %s from class %s.",
+                        "Failed to find function %s, class %s does not exist.",
                         FunctionName.c_str(), ClassName.c_str() );
-                return FunctionInfo;
+                return GetInvalidFunctionInfo();
         }
 
-        FunctionInfo.Func = result;
+        return GetFunctionByName( Class, FunctionName );
+}
+
+const SDK::FFunctionInfo &
+SDK::FKismetPropertyLibrary::GetFunctionByName( UStruct *Struct,
+                                                std::string_view FunctionName ) {
+        const FStructInfo *Info = GetStructInfo( Struct );
+        if ( !Info )
+                return GetInvalidFunctionInfo();
+
+        auto Found = Info->Functions.find( FunctionName );
+        if ( Found != Info->Functions.end() )
+                return Found->second;
+
+        UE_LOG( LogFortSDK, VeryVerbose,
+                "Failed to find function %.*s from class %s.",
+                static_cast<int>( FunctionName.size() ), FunctionName.data(),
+                Struct->GetFName().ToString().ToString().c_str() );
+        return GetInvalidFunctionInfo();
+}
+
+/*Values that own nothing, freeing the array behind them is enough*/
+static bool IsTriviallyDestructible( const SDK::FPropertyRef &Prop ) {
+        using namespace SDK;
+        return ( Prop.GetPropertyFlags() &
+                 ( CPF_IsPlainOldData | CPF_NoDestructor ) ) ||
+               Prop.HasAnyCastFlags(
+                   CASTCLASS_FNumericProperty | CASTCLASS_FBoolProperty |
+                   CASTCLASS_FNameProperty | CASTCLASS_FObjectProperty |
+                   CASTCLASS_FWeakObjectProperty | CASTCLASS_FInterfaceProperty |
+                   CASTCLASS_FEnumProperty );
+}
+
+/*FString, or a TArray whose elements are trivial or can be freed the same way*/
+static bool CanFreeValue( const SDK::FPropertyRef &Prop ) {
+        using namespace SDK;
+        if ( Prop.HasAnyCastFlags( CASTCLASS_FStrProperty ) )
+                return true;
+        if ( !Prop.HasAnyCastFlags( CASTCLASS_FArrayProperty ) )
+                return false;
+
+        FPropertyRef Inner = FArrayPropertyRef( Prop.Get() ).GetInner();
+        return Inner.IsValid() &&
+               ( IsTriviallyDestructible( Inner ) || CanFreeValue( Inner ) );
+}
+
+/*FString is a TArray<wchar_t>, both start with the Data pointer*/
+static void FreeValue( uint8_t *Value, const SDK::FPropertyRef &Prop ) {
+        using namespace SDK;
+        void *&Allocation = *reinterpret_cast<void **>( Value );
+        if ( !Allocation )
+                return;
 
-        AllFunctionInfo.push_back( FunctionInfo );
-        return FunctionInfo;
-}
\ No newline at end of file
+        if ( Prop.HasAnyCastFlags( CASTCLASS_FArrayProperty ) ) {
+                FPropertyRef Inner = FArrayPropertyRef( Prop.Get() ).GetInner();
+                if ( !IsTriviallyDestructible( Inner ) ) {
+                        const auto *Array =
+                            reinterpret_cast<TArray<uint8> *>( Value );
+                        for ( int32_t i = 0; i < Array->Num(); i++ )
+                                FreeValue( static_cast<uint8_t *>( Allocation ) +
+                                               i * Inner.GetElementSize(),
+                                           Inner );
+                }
+        }
+
+        FMemory::Free( Allocation );
+        Allocation = nullptr;
+}
+
+const SDK::FFunctionParamsInfo *
+SDK::FKismetPropertyLibrary::GetFunctionParamsInfo( UFunction *Func ) {
+        if ( !Func )
+                return nullptr;
+
+        {
+                std::shared_lock Lock( FunctionParamsInfoLock );
+                auto Found = AllFunctionParamsInfo.find( Func );
+                if ( Found != AllFunctionParamsInfo.end() )
+                        return Found->second.get();
+        }
+
+        std::unique_ptr<FFunctionParamsInfo> Info =
+            std::make_unique<FFunctionParamsInfo>();
+        Info->Func = Func;
+        Info->bWasNative = Func->HasAnyFunctionFlags( FUNC_Native );
+
+        /*PropertyLink first, then anything only reachable through the
+         * children, same order CallFunc has always used*/
+        FMemStackScope Scope;
+        std::pmr::vector<void *> Seen( Scope.GetResource() );
+        auto AddParam = [&]( void *Prop ) {
+                if ( std::find( Seen.begin(), Seen.end(), Prop ) != Seen.end() )
+                        return;
+                Seen.push_back( Prop );
+
+                FKismetPropertyManager Manager{ Prop };
+                FParamInfo Param{};
+                Param.Prop = Prop;
+                Param.PropertyFlags = Manager.GetPropertyFlags();
+                if ( !( Param.PropertyFlags & CPF_Parm ) )
+                        return; /*Locals of script functions*/
+
+                Param.Offset = Manager.GetOffset();
+                Param.ElementSize = Manager.GetElementSize();
+                Param.ArrayDim = Manager.GetArrayDim();
+                Param.Size = Param.ElementSize * Param.ArrayDim;
+                Info->ParmsSize =
+                    ( std::max )( Info->ParmsSize, Param.Offset + Param.Size );
+
+                if ( Param.IsReturn() )
+                        Info->ReturnValue = Param;
+                else
+                        Info->Params.push_back( Param );
+        };
+
+        ForEachLinkedProperty( Func, AddParam );
+        ForEachOwnProperty( Func, AddParam );
+
+        /*Params only give a lower bound, the engine's own size has the
+         * trailing padding ProcessEvent expects. Kept as a max so builds
+         * with RepOffset ahead of NumParms can't shrink the frame*/
+        Info->ParmsSize = ( std::max )( Info->ParmsSize,
+                                        int32_t( Func->ParmsSize() ) );
+
+        ForEachDestructorLinkProperty( Func, [&]( void *Prop ) {
+                FParamInfo *Param = nullptr;
+                if ( Info->ReturnValue.Prop == Prop ) {
+                        Param = &Info->ReturnValue;
+                } else {
+                        for ( FParamInfo &Other : Info->Params ) {
+                                if ( Other.Prop == Prop ) {
+                                        Param = &Other;
+                                        break;
+                                }
+                        }
+                }
+                if ( !Param )
+                        return;
+
+                FPropertyRef Ref( Prop );
+                Param->Cleanup = CanFreeValue( Ref )
+                                     ? EParamCleanup::FreeAllocation
+                                     : EParamCleanup::Unsupported;
+                if ( Param->Cleanup == EParamCleanup::Unsupported &&
+                     Ref.HasAnyCastFlags( CASTCLASS_FArrayProperty ) )
+                        UE_LOG( LogFortSDK, Warning,
+                                "%s of %s holds elements that can't be "
+                                "destroyed, its values will leak",
+                                Ref.GetName().c_str(),
+                                Func->GetFName().ToString().ToString().c_str() );
+        } );
+
+        UE_LOG( LogFortSDK, VeryVerbose,
+                "Built params info for %s: %zu params, ParmsSize %d",
+                Func->GetFName().ToString().ToString().c_str(),
+                Info->NumParams(), Info->ParmsSize );
+
+        std::unique_lock Lock( FunctionParamsInfoLock );
+        auto Result = AllFunctionParamsInfo.try_emplace( Func, std::move( Info ) );
+        return Result.first->second.get();
+}
+
+SDK::FFunctionParamsFrame::FFunctionParamsFrame(
+    const FFunctionParamsInfo *InInfo )
+    : Info( InInfo ), Mark( FMemStack::Get() ) {
+        const size_t ParmsSize = Info ? Info->ParmsSize : 0;
+
+        Data = ParmsSize <= InlineSize
+                   ? InlineData
+                   : FMemStack::Get().PushBytes( ParmsSize, 16 );
+        std::memset( Data, 0, ParmsSize );
+}
+
+SDK::FFunctionParamsFrame::~FFunctionParamsFrame() {
+        if ( Info )
+                Info->DestroyParams( Data, CallerOwnedMask, bOwnsReturnValue );
+}
+
+static void DestroyParam( uint8_t *Data, const SDK::FParamInfo &Param ) {
+        if ( Param.Cleanup != SDK::EParamCleanup::FreeAllocation )
+                return;
+
+        const SDK::FPropertyRef Prop( Param.Prop );
+        for ( int32_t i = 0; i < Param.ArrayDim; i++ )
+                FreeValue( Data + Param.Offset + i * Param.ElementSize, Prop );
+}
+
+void SDK::FFunctionParamsInfo::DestroyParams( uint8_t *Data,
+                                              uint64_t CallerOwnedMask,
+                                              bool bDestroyReturnValue,
+                                              uint64_t OwnedInputMask ) const {
+        /*Only pure out params are ours, anything the caller passed in or
+         * passes by reference still belongs to the caller*/
+        for ( size_t i = 0; i < Params.size(); i++ ) {
+                const FParamInfo &Param = Params[i];
+                if ( Param.Cleanup == EParamCleanup::None )
+                        continue;
+                if ( i < 64 && ( OwnedInputMask & ( uint64_t( 1 ) << i ) ) ) {
+                        DestroyParam( Data, Param );
+                        continue;
+                }
+                if ( !Param.IsOut() || Param.IsRef() )
+                        continue;
+                if ( i < 64 && ( CallerOwnedMask & ( uint64_t( 1 ) << i ) ) )
+                        continue;
+                DestroyParam( Data, Param );
+        }
+
+        if ( bDestroyReturnValue && ReturnValue.Offset != -1 &&
+             ReturnValue.Cleanup != EParamCleanup::None )
+                DestroyParam( Data, ReturnValue );
+}
@@ -0,0 +1,484 @@
+#include "pch.h"
+#include "../../include/SDK.h"
+
+namespace
+{
+/*What TArray and FString look like in memory, whatever the element type*/
+struct FRawArray {
+        uint8_t *Data;
+        int32_t Num;
+        int32_t Max;
+};
+
+struct FWriter {
+        std::vector<uint8_t> &Out;
+
+        FORCEINLINE void Write( const void *Src, size_t Size ) {
+                const size_t Pos = Out.size();
+                Out.resize( Pos + Size );
+                std::memcpy( Out.data() + Pos, Src, Size );
+        }
+        template <typename T> FORCEINLINE void Write( const T &Value ) {
+                Write( &Value, sizeof( T ) );
+        }
+};
+
+struct FReader {
+        const uint8_t *Cur;
+        const uint8_t *End;
+
+        FORCEINLINE bool Read( void *Dst, size_t Size ) {
+                if ( size_t( End - Cur ) < Size )
+                        return false;
+                std::memcpy( Dst, Cur, Size );
+                Cur += Size;
+                return true;
+        }
+        template <typename T> FORCEINLINE bool Read( T &Value ) {
+                return Read( &Value, sizeof( T ) );
+        }
+};
+
+bool IsPlainOldDataType( SDK::EPropertyType Type ) {
+        switch ( Type ) {
+        case SDK::EPropertyType::Bool:
+        case SDK::EPropertyType::Int8:
+        case SDK::EPropertyType::Byte:
+        case SDK::EPropertyType::Int16:
+        case SDK::EPropertyType::UInt16:
+        case SDK::EPropertyType::Int:
+        case SDK::EPropertyType::UInt32:
+        case SDK::EPropertyType::Int64:
+        case SDK::EPropertyType::UInt64:
+        case SDK::EPropertyType::Float:
+        case SDK::EPropertyType::Double:
+        case SDK::EPropertyType::Name:
+        case SDK::EPropertyType::Enum:
+        /*Index and serial number, same as what we'd write for a hard reference*/
+        case SDK::EPropertyType::WeakObject:
+                return true;
+        default:
+                return false;
+        }
+}
+
+/*Appends a span, merging it into the previous one if they touch or overlap (bitfield bools share a byte)*/
+void AddSpan( std::vector<SDK::FSerializeOp> &Ops, int32_t Offset, int32_t Size ) {
+        if ( Size <= 0 )
+                return;
+
+        if ( !Ops.empty() && Ops.back().Op == SDK::ESerializeOp::Span &&
+             Ops.back().Offset + Ops.back().Size >= Offset ) {
+                SDK::FSerializeOp &Last = Ops.back();
+                Last.Size = ( std::max )( Last.Size, Offset + Size - Last.Offset );
+                return;
+        }
+
+        SDK::FSerializeOp Op;
+        Op.Offset = Offset;
+        Op.Size = Size;
+        Ops.push_back( std::move( Op ) );
+}
+
+/*Array whose elements are one span without padding, the whole allocation is a single copy*/
+FORCEINLINE bool IsDenseSpan( const SDK::FSerializeOp &ArrayOp ) {
+        const SDK::FSerializeOp &Inner = *ArrayOp.Inner;
+        return Inner.Op == SDK::ESerializeOp::Span && Inner.Offset == 0 &&
+               Inner.Size == ArrayOp.Stride;
+}
+
+/*Fewest bytes Op can take up in a stream, what a count read from one is checked against before anything is allocated*/
+size_t MinEncodedSize( const SDK::FSerializeOp &Op ) {
+        switch ( Op.Op ) {
+        case SDK::ESerializeOp::Span:
+                return size_t( Op.Size );
+        case SDK::ESerializeOp::Str:
+        case SDK::ESerializeOp::Array:
+                return sizeof( int32_t ) * Op.ArrayDim;
+        case SDK::ESerializeOp::Object:
+                return sizeof( int32_t ) * 2 * Op.ArrayDim;
+        case SDK::ESerializeOp::Struct: {
+                size_t Size = 0;
+                for ( const SDK::FSerializeOp &Member :
+                      SDK::SerializationLibrary->GetLayout( Op.Struct )->Ops )
+                        Size += MinEncodedSize( Member );
+                return Size * Op.ArrayDim;
+        }
+        default:
+                return 0;
+        }
+}
+
+void WriteOp( const SDK::FSerializeOp &Op, const uint8_t *Data, FWriter &Writer );
+bool ReadOp( const SDK::FSerializeOp &Op, uint8_t *Data, FReader &Reader );
+
+void WriteOps( const std::vector<SDK::FSerializeOp> &Ops, const uint8_t *Data,
+               FWriter &Writer ) {
+        for ( const SDK::FSerializeOp &Op : Ops )
+                WriteOp( Op, Data, Writer );
+}
+
+bool ReadOps( const std::vector<SDK::FSerializeOp> &Ops, uint8_t *Data,
+              FReader &Reader ) {
+        for ( const SDK::FSerializeOp &Op : Ops ) {
+                if ( !ReadOp( Op, Data, Reader ) )
+                        return false;
+        }
+        return true;
+}
+
+void WriteObject( SDK::UObject *Object, FWriter &Writer ) {
+        int32_t Index = -1;
+        int32_t Serial = 0;
+        if ( Object ) {
+                Index = int32_t( Object->GetUniqueID() );
+                Serial = SDK::GUObjectArray.AllocateSerialNumber( Index );
+        }
+        Writer.Write( Index );
+        Writer.Write( Serial );
+}
+
+bool ReadObject( SDK::UObject *&Object, FReader &Reader ) {
+        int32_t Index, Serial;
+        if ( !Reader.Read( Index ) || !Reader.Read( Serial ) )
+                return false;
+
+        Object = nullptr;
+        if ( Index < 0 )
+                return true;
+
+        /*A different serial means the slot was reused, the object we wrote is gone.
+         * Serial 0 can't tell the two apart, so such a reference reads back as null*/
+        if ( Serial == 0 )
+                return true;
+        SDK::FUObjectItem *Item = SDK::GUObjectArray.IndexToObject( Index );
+        if ( Item && Item->GetSerialNumber() == Serial )
+                Object = static_cast<SDK::UObject *>( Item->Object );
+        return true;
+}
+
+/*Resizes Array to Num elements of ElementSize, new elements are zeroed*/
+void ResizeRawArray( FRawArray &Array, int32_t Num, int32_t ElementSize ) {
+        if ( Num > Array.Max ) {
+                Array.Data = static_cast<uint8_t *>( SDK::FMemory::Realloc(
+                    Array.Data, uint64_t( Num ) * ElementSize ) );
+                Array.Max = Num;
+        }
+        if ( Num > Array.Num )
+                std::memset( Array.Data + size_t( Array.Num ) * ElementSize, 0,
+                             size_t( Num - Array.Num ) * ElementSize );
+        Array.Num = Num;
+}
+
+void WriteOp( const SDK::FSerializeOp &Op, const uint8_t *Data, FWriter &Writer ) {
+        if ( Op.Op == SDK::ESerializeOp::Span ) {
+                Writer.Write( Data + Op.Offset, Op.Size );
+                return;
+        }
+
+        for ( int32_t i = 0; i < Op.ArrayDim; i++ ) {
+                const uint8_t *Value = Data + Op.Offset + i * Op.Size;
+
+                switch ( Op.Op ) {
+                case SDK::ESerializeOp::Str: {
+                        const FRawArray &Str = *reinterpret_cast<const FRawArray *>( Value );
+                        Writer.Write( Str.Num );
+                        Writer.Write( Str.Data, size_t( Str.Num ) * sizeof( wchar_t ) );
+                        break;
+                }
+                case SDK::ESerializeOp::Object:
+                        WriteObject( *reinterpret_cast<SDK::UObject *const *>( Value ),
+                                     Writer );
+                        break;
+                case SDK::ESerializeOp::Array: {
+                        const FRawArray &Array = *reinterpret_cast<const FRawArray *>( Value );
+                        const SDK::FSerializeOp &Inner = *Op.Inner;
+                        Writer.Write( Array.Num );
+                        if ( IsDenseSpan( Op ) ) {
+                                Writer.Write( Array.Data, size_t( Array.Num ) * Op.Stride );
+                                break;
+                        }
+                        for ( int32_t j = 0; j < Array.Num; j++ )
+                                WriteOp( Inner, Array.Data + size_t( j ) * Op.Stride,
+                                         Writer );
+                        break;
+                }
+                case SDK::ESerializeOp::Struct:
+                        WriteOps( SDK::SerializationLibrary->GetLayout( Op.Struct )->Ops,
+                                  Value, Writer );
+                        break;
+                default:
+                        break;
+                }
+        }
+}
+
+bool ReadOp( const SDK::FSerializeOp &Op, uint8_t *Data, FReader &Reader ) {
+        if ( Op.Op == SDK::ESerializeOp::Span )
+                return Reader.Read( Data + Op.Offset, Op.Size );
+
+        for ( int32_t i = 0; i < Op.ArrayDim; i++ ) {
+                uint8_t *Value = Data + Op.Offset + i * Op.Size;
+
+                switch ( Op.Op ) {
+                case SDK::ESerializeOp::Str: {
+                        FRawArray &Str = *reinterpret_cast<FRawArray *>( Value );
+                        int32_t Num;
+                        if ( !Reader.Read( Num ) || Num < 0 ||
+                             size_t( Num ) * sizeof( wchar_t ) >
+                                 size_t( Reader.End - Reader.Cur ) )
+                                return false;
+                        ResizeRawArray( Str, Num, sizeof( wchar_t ) );
+                        if ( !Reader.Read( Str.Data, size_t( Num ) * sizeof( wchar_t ) ) )
+                                return false;
+                        break;
+                }
+                case SDK::ESerializeOp::Object:
+                        if ( !ReadObject( *reinterpret_cast<SDK::UObject **>( Value ),
+                                          Reader ) )
+                                return false;
+                        break;
+                case SDK::ESerializeOp::Array: {
+                        FRawArray &Array = *reinterpret_cast<FRawArray *>( Value );
+                        const SDK::FSerializeOp &Inner = *Op.Inner;
+                        /*Every element takes at least this much of the stream, a count that doesn't fit is rejected before the allocation*/
+                        const size_t MinElementSize = ( std::max )(
+                            IsDenseSpan( Op ) ? size_t( Op.Stride )
+                                              : MinEncodedSize( Inner ),
+                            size_t( 1 ) );
+                        int32_t Num;
+                        if ( !Reader.Read( Num ) || Num < 0 ||
+                             size_t( Num ) * MinElementSize >
+                                 size_t( Reader.End - Reader.Cur ) )
+                                return false;
+                        /*Elements dropped off the end keep whatever they allocated, only the array itself is resized*/
+                        ResizeRawArray( Array, Num, Op.Stride );
+                        if ( IsDenseSpan( Op ) ) {
+                                if ( !Reader.Read( Array.Data, size_t( Num ) * Op.Stride ) )
+                                        return false;
+                                break;
+                        }
+                        for ( int32_t j = 0; j < Num; j++ ) {
+                                if ( !ReadOp( Inner, Array.Data + size_t( j ) * Op.Stride,
+                                              Reader ) )
+                                        return false;
+                        }
+                        break;
+                }
+                case SDK::ESerializeOp::Struct:
+                        if ( !ReadOps( SDK::SerializationLibrary->GetLayout( Op.Struct )->Ops,
+                                       Value, Reader ) )
+                                return false;
+                        break;
+                default:
+                        break;
+                }
+        }
+        return true;
+}
+}
+
+static thread_local std::vector<SDK::UStruct *> LayoutsBeingBuilt;
+
+/*Turns one property into ops appended to Ops, BaseOffset is where its container starts*/
+static bool AddPropertyOps( SDK::FKismetSerializationLibrary &Library,
+                            const SDK::FPropertyRef &Ref, int32_t BaseOffset,
+                            std::vector<SDK::FSerializeOp> &Ops ) {
+        const int32_t Offset = BaseOffset + Ref.GetOffset();
+        const SDK::EPropertyType Type = Ref.GetType();
+
+        if ( IsPlainOldDataType( Type ) ) {
+                AddSpan( Ops, Offset, Ref.GetSize() );
+                return true;
+        }
+
+        SDK::FSerializeOp Op;
+        Op.Offset = Offset;
+        Op.Size = Ref.GetElementSize();
+        Op.ArrayDim = Ref.GetArrayDim();
+
+        switch ( Type ) {
+        case SDK::EPropertyType::Str:
+                Op.Op = SDK::ESerializeOp::Str;
+                break;
+        case SDK::EPropertyType::Object:
+        case SDK::EPropertyType::Class:
+                Op.Op = SDK::ESerializeOp::Object;
+                break;
+        case SDK::EPropertyType::Struct: {
+                SDK::UStruct *Struct =
+                    SDK::CastProperty<SDK::FStructPropertyRef>( Ref ).GetStruct();
+                if ( !Struct )
+                        return false;
+                /*A struct reaching itself through an array is still being built, refer to it by op*/
+                const bool bBuilding =
+                    std::find( LayoutsBeingBuilt.begin(), LayoutsBeingBuilt.end(),
+                               Struct ) != LayoutsBeingBuilt.end();
+                const SDK::FSerializationLayout *Nested =
+                    bBuilding ? nullptr : Library.GetLayout( Struct );
+                /*POD structs are folded into the parent so they coalesce with their neighbours*/
+                if ( Nested && Nested->IsPlainOldData() ) {
+                        for ( int32_t i = 0; i < Op.ArrayDim; i++ ) {
+                                for ( const SDK::FSerializeOp &Span : Nested->Ops )
+                                        AddSpan( Ops, Offset + i * Op.Size + Span.Offset,
+                                                 Span.Size );
+                        }
+                        return true;
+                }
+                Op.Op = SDK::ESerializeOp::Struct;
+                Op.Struct = Struct;
+                break;
+        }
+        case SDK::EPropertyType::Array: {
+                SDK::FPropertyRef InnerRef =
+                    SDK::CastProperty<SDK::FArrayPropertyRef>( Ref ).GetInner();
+                std::vector<SDK::FSerializeOp> InnerOps;
+                if ( !InnerRef.IsValid() ||
+                     !AddPropertyOps( Library, InnerRef, -InnerRef.GetOffset(),
+                                      InnerOps ) )
+                        return false;
+
+                Op.Op = SDK::ESerializeOp::Array;
+                Op.Stride = InnerRef.GetElementSize();
+                if ( InnerOps.size() == 1 ) {
+                        Op.Inner = std::make_unique<SDK::FSerializeOp>(
+                            std::move( InnerOps[0] ) );
+                } else {
+                        /*A POD struct that didn't coalesce into a single span, write each element through its layout*/
+                        Op.Inner = std::make_unique<SDK::FSerializeOp>();
+                        Op.Inner->Op = SDK::ESerializeOp::Struct;
+                        Op.Inner->Size = InnerRef.GetElementSize();
+                        Op.Inner->Struct =
+                            SDK::CastProperty<SDK::FStructPropertyRef>( InnerRef ).GetStruct();
+                        if ( !Op.Inner->Struct )
+                                return false;
+                }
+                break;
+        }
+        default:
+                return false;
+        }
+
+        Ops.push_back( std::move( Op ) );
+        return true;
+}
+
+const SDK::FSerializationLayout *
+SDK::FKismetSerializationLibrary::GetLayout( UStruct *Struct ) {
+        if ( !Struct )
+                return nullptr;
+
+        {
+                std::shared_lock Lock( LayoutsLock );
+                auto Found = Layouts.find( Struct );
+                if ( Found != Layouts.end() )
+                        return Found->second.get();
+        }
+
+        const FStructInfo *StructInfo = PropLibrary->GetStructInfo( Struct );
+        if ( !StructInfo )
+                return nullptr;
+
+        std::vector<const FPropertyRef *> Props;
+        Props.reserve( StructInfo->Properties.size() );
+        for ( const auto &[Name, PropInfo] : StructInfo->Properties )
+                Props.push_back( &PropInfo.Ref );
+        std::sort( Props.begin(), Props.end(),
+                   []( const FPropertyRef *A, const FPropertyRef *B ) {
+                           return A->GetOffset() < B->GetOffset();
+                   } );
+
+        std::unique_ptr<FSerializationLayout> Layout =
+            std::make_unique<FSerializationLayout>();
+        Layout->Struct = Struct;
+        LayoutsBeingBuilt.push_back( Struct );
+        for ( const FPropertyRef *Ref : Props ) {
+                if ( !AddPropertyOps( *this, *Ref, 0, Layout->Ops ) ) {
+                        Layout->NumSkipped++;
+                        UE_LOG( LogFortSDK, VeryVerbose,
+                                "Serialization skips %s, unsupported property type",
+                                Ref->GetName().c_str() );
+                }
+        }
+        LayoutsBeingBuilt.pop_back();
+
+        UE_LOG( LogFortSDK, VeryVerbose,
+                "Built serialization layout for %s: %zu ops, %d skipped",
+                Struct->GetFName().ToString().ToString().c_str(),
+                Layout->Ops.size(), Layout->NumSkipped );
+
+        std::unique_lock Lock( LayoutsLock );
+        auto Result = Layouts.try_emplace( Struct, std::move( Layout ) );
+        return Result.first->second.get();
+}
+
+bool SDK::FKismetSerializationLibrary::SerializeStruct( UStruct *Struct,
+                                                        const void *Data,
+                                                        std::vector<uint8_t> &Out ) {
+        const FSerializationLayout *Layout = GetLayout( Struct );
+        if ( !Layout || !Data )
+                return false;
+
+        FWriter Writer{ Out };
+        Writer.Write( int32_t( Struct->GetSize() ) );
+        WriteOps( Layout->Ops, static_cast<const uint8_t *>( Data ), Writer );
+        return true;
+}
+
+bool SDK::FKismetSerializationLibrary::DeserializeStruct( UStruct *Struct,
+                                                          void *Data,
+                                                          const uint8_t *In,
+                                                          size_t Size ) {
+        const FSerializationLayout *Layout = GetLayout( Struct );
+        if ( !Layout || !Data || !In )
+                return false;
+
+        FReader Reader{ In, In + Size };
+        int32_t StructSize;
+        if ( !Reader.Read( StructSize ) || StructSize != Struct->GetSize() ) {
+                UE_LOG( LogFortSDK, Warning,
+                        "DeserializeStruct: stream was written for a different "
+                        "layout of %s",
+                        Struct->GetFName().ToString().ToString().c_str() );
+                return false;
+        }
+
+        if ( !ReadOps( Layout->Ops, static_cast<uint8_t *>( Data ), Reader ) ) {
+                UE_LOG( LogFortSDK, Warning,
+                        "DeserializeStruct: stream for %s is truncated",
+                        Struct->GetFName().ToString().ToString().c_str() );
+                return false;
+        }
+        return true;
+}
+
+void SDK::FKismetSerializationLibrary::BenchmarkSerialization( UObject *Object,
+                                                               int32_t Iterations ) {
+        if ( !Object || Iterations <= 0 )
+                return;
+
+        std::vector<uint8_t> Buffer;
+        if ( !SerializeObject( Object, Buffer ) )
+                return;
+        const size_t StreamSize = Buffer.size();
+
+        auto Start = std::chrono::steady_clock::now();
+        for ( int32_t i = 0; i < Iterations; i++ ) {
+                Buffer.clear();
+                SerializeObject( Object, Buffer );
+        }
+        auto Mid = std::chrono::steady_clock::now();
+        for ( int32_t i = 0; i < Iterations; i++ )
+                DeserializeObject( Object, Buffer.data(), Buffer.size() );
+        auto End = std::chrono::steady_clock::now();
+
+        const double TotalMB = double( StreamSize ) * Iterations / ( 1024.0 * 1024.0 );
+        const double WriteSeconds = std::chrono::duration<double>( Mid - Start ).count();
+        const double ReadSeconds = std::chrono::duration<double>( End - Mid ).count();
+
+        UE_LOG( LogFortSDK, Log,
+                "%s: %zu byte stream, serialize %.1f MB/s, deserialize %.1f MB/s",
+                Object->GetFName().ToString().ToString().c_str(), StreamSize,
+                WriteSeconds > 0 ? TotalMB / WriteSeconds : 0.0,
+                ReadSeconds > 0 ? TotalMB / ReadSeconds : 0.0 );
+}
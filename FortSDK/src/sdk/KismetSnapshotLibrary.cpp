@@ -0,0 +1,228 @@
+#include "pch.h"
+#include "../../include/SDK.h"
+
+std::pair<const SDK::FSnapshotLayout::FProp *, const SDK::FSnapshotLayout::FProp *>
+SDK::FSnapshotLayout::FindProps( int32_t Offset ) const {
+        auto It = std::upper_bound(
+            Props.begin(), Props.end(), Offset,
+            []( int32_t Value, const FProp &Prop ) { return Value < Prop.Offset; } );
+        if ( It == Props.begin() || Offset >= ( It - 1 )->End )
+                return { nullptr, nullptr };
+
+        /*Only bitfield bools start on the same byte, step back over all of them*/
+        auto First = It - 1;
+        while ( First != Props.begin() && ( First - 1 )->Offset == First->Offset )
+                --First;
+        return { &*First, &*First + ( It - First ) };
+}
+
+int32_t SDK::FSnapshotLayout::PackedToSrc( int32_t PackedOffset ) const {
+        auto It = std::upper_bound( Spans.begin(), Spans.end(), PackedOffset,
+                                    []( int32_t Value, const FSpan &Span ) {
+                                            return Value < Span.PackedOffset;
+                                    } );
+        if ( It == Spans.begin() )
+                return -1;
+        --It;
+        return It->SrcOffset + ( PackedOffset - It->PackedOffset );
+}
+
+const SDK::FSnapshotLayout *SDK::FKismetSnapshotLibrary::GetLayout( UClass *Class ) {
+        auto Found = Layouts.find( Class );
+        if ( Found != Layouts.end() )
+                return Found->second.get();
+
+        const FSerializationLayout *Serialization =
+            SerializationLibrary->GetLayout( Class );
+        const FStructInfo *StructInfo = PropLibrary->GetStructInfo( Class );
+        if ( !Serialization || !StructInfo )
+                return nullptr;
+
+        /*The serializer already coalesced the POD properties into spans, reuse them*/
+        std::unique_ptr<FSnapshotLayout> Layout = std::make_unique<FSnapshotLayout>();
+        int32_t Packed = 0;
+        for ( const FSerializeOp &Op : Serialization->Ops ) {
+                if ( Op.Op != ESerializeOp::Span )
+                        continue;
+                Layout->Spans.push_back( { Op.Offset, Op.Size, Packed } );
+                Packed += Op.Size;
+        }
+        Layout->PackedSize = ( Packed + 15 ) & ~15;
+
+        for ( const auto &[Name, PropInfo] : StructInfo->Properties ) {
+                const FPropertyRef &Ref = PropInfo.Ref;
+                int32_t Offset = Ref.GetOffset();
+                int32_t End = Offset + Ref.GetSize();
+                uint8_t FieldMask = 0xFF;
+                if ( Ref.HasAnyCastFlags( CASTCLASS_FBoolProperty ) ) {
+                        /*Narrowed to the one byte the bool reads, same as FBoolPropertyRef*/
+                        const FBoolPropertyRef Bool( Ref.Get() );
+                        Offset += Bool.GetByteOffset();
+                        End = Offset + 1;
+                        FieldMask = Bool.GetFieldMask();
+                }
+                const bool bInSpan = std::any_of(
+                    Layout->Spans.begin(), Layout->Spans.end(),
+                    [&]( const FSnapshotLayout::FSpan &Span ) {
+                            return Offset >= Span.SrcOffset &&
+                                   End <= Span.SrcOffset + Span.Size;
+                    } );
+                if ( bInSpan && End > Offset )
+                        Layout->Props.push_back( { Offset, End, &Ref, FieldMask } );
+        }
+        std::sort( Layout->Props.begin(), Layout->Props.end(),
+                   []( const FSnapshotLayout::FProp &A,
+                       const FSnapshotLayout::FProp &B ) {
+                           return A.Offset < B.Offset;
+                   } );
+
+        auto Result = Layouts.try_emplace( Class, std::move( Layout ) );
+        return Result.first->second.get();
+}
+
+void SDK::FKismetSnapshotLibrary::Track( UObject *Object ) {
+        if ( !Object )
+                return;
+        for ( const FEntry &Entry : Entries ) {
+                if ( Entry.Object == Object )
+                        return;
+        }
+
+        const FSnapshotLayout *Layout = GetLayout( Object->GetClass() );
+        if ( !Layout )
+                return;
+
+        /*Without a serial, Capture couldn't notice the slot going to another object*/
+        const int32_t Index = int32_t( Object->GetUniqueID() );
+        const int32_t SerialNumber = GUObjectArray.AllocateSerialNumber( Index );
+        if ( SerialNumber == 0 ) {
+                UE_LOG( LogFortSDK, Warning,
+                        "Not tracking an object without a serial number" );
+                return;
+        }
+
+        Entries.push_back( { Object, Index, SerialNumber, Layout, 0, false } );
+        bNeedsRelayout = true;
+}
+
+void SDK::FKismetSnapshotLibrary::Untrack( UObject *Object ) {
+        auto It = std::find_if( Entries.begin(), Entries.end(),
+                                [&]( const FEntry &Entry ) {
+                                        return Entry.Object == Object;
+                                } );
+        if ( It == Entries.end() )
+                return;
+        Entries.erase( It );
+        bNeedsRelayout = true;
+}
+
+void SDK::FKismetSnapshotLibrary::Clear() {
+        Entries.clear();
+        Previous = FAlignedBuffer();
+        Current = FAlignedBuffer();
+        bNeedsRelayout = false;
+}
+
+void SDK::FKismetSnapshotLibrary::Relayout() {
+        bNeedsRelayout = false;
+
+        size_t TotalSize = 0;
+        std::vector<size_t> OldOffsets;
+        OldOffsets.reserve( Entries.size() );
+        for ( FEntry &Entry : Entries ) {
+                OldOffsets.push_back( Entry.Offset );
+                Entry.Offset = TotalSize;
+                TotalSize += Entry.Layout->PackedSize;
+        }
+
+        FAlignedBuffer NewPrevious;
+        NewPrevious.NumBlocks = TotalSize / 16;
+        NewPrevious.Blocks.reset( new __m128i[NewPrevious.NumBlocks]() );
+        for ( size_t i = 0; i < Entries.size(); i++ ) {
+                if ( Entries[i].bHasBaseline )
+                        std::memcpy( NewPrevious.Data() + Entries[i].Offset,
+                                     Previous.Data() + OldOffsets[i],
+                                     Entries[i].Layout->PackedSize );
+        }
+        Previous = std::move( NewPrevious );
+
+        Current.NumBlocks = TotalSize / 16;
+        Current.Blocks.reset( new __m128i[Current.NumBlocks]() );
+}
+
+void SDK::FKismetSnapshotLibrary::Capture( std::vector<FPropertyChange> &OutChanges ) {
+        /*Slots get reused, a different serial number means the object we tracked is gone*/
+        const size_t NumBefore = Entries.size();
+        std::erase_if( Entries, []( const FEntry &Entry ) {
+                FUObjectItem *Item = GUObjectArray.IndexToObject( Entry.Index );
+                return !Item || Item->Object != Entry.Object ||
+                       Item->GetSerialNumber() != Entry.SerialNumber;
+        } );
+        if ( Entries.size() != NumBefore || bNeedsRelayout )
+                Relayout();
+
+        uint8_t *CurrentData = Current.Data();
+        const uint8_t *PreviousData = Previous.Data();
+        const __m128i *PreviousBlocks = Previous.Blocks.get();
+        const __m128i *CurrentBlocks = Current.Blocks.get();
+
+        for ( FEntry &Entry : Entries ) {
+                const FSnapshotLayout &Layout = *Entry.Layout;
+                const uint8_t *Src = reinterpret_cast<const uint8_t *>( Entry.Object );
+                uint8_t *Dst = CurrentData + Entry.Offset;
+                for ( const FSnapshotLayout::FSpan &Span : Layout.Spans )
+                        std::memcpy( Dst + Span.PackedOffset, Src + Span.SrcOffset,
+                                     Span.Size );
+
+                if ( !Entry.bHasBaseline ) {
+                        Entry.bHasBaseline = true;
+                        continue;
+                }
+
+                const size_t FirstBlock = Entry.Offset / 16;
+                const size_t EndBlock = FirstBlock + Layout.PackedSize / 16;
+                /*Packed offset (relative to the entry) up to which changes are already reported*/
+                int32_t ReportedUntil = 0;
+                for ( size_t Block = FirstBlock; Block < EndBlock; Block++ ) {
+                        uint32_t Mask =
+                            ~uint32_t( _mm_movemask_epi8( _mm_cmpeq_epi8(
+                                PreviousBlocks[Block], CurrentBlocks[Block] ) ) ) &
+                            0xFFFF;
+
+                        const int32_t BlockStart = int32_t( ( Block - FirstBlock ) * 16 );
+                        while ( Mask ) {
+                                const int32_t Packed = BlockStart + std::countr_zero( Mask );
+                                Mask &= Mask - 1;
+                                if ( Packed < ReportedUntil )
+                                        continue;
+
+                                const int32_t SrcOffset = Layout.PackedToSrc( Packed );
+                                const auto [First, Last] = Layout.FindProps( SrcOffset );
+                                if ( First == Last ) {
+                                        ReportedUntil = Packed + 1;
+                                        continue;
+                                }
+
+                                if ( First->FieldMask != 0xFF ) {
+                                        /*Bools sharing this byte, only the ones whose bits flipped changed*/
+                                        const uint8_t ChangedBits =
+                                            PreviousData[Entry.Offset + Packed] ^
+                                            CurrentData[Entry.Offset + Packed];
+                                        for ( const auto *Prop = First; Prop != Last; Prop++ ) {
+                                                if ( Prop->FieldMask & ChangedBits )
+                                                        OutChanges.push_back(
+                                                            { Entry.Object, Prop->Ref } );
+                                        }
+                                        ReportedUntil = Packed + 1;
+                                        continue;
+                                }
+
+                                OutChanges.push_back( { Entry.Object, First->Ref } );
+                                /*A property never crosses a span, so its end is the same distance away in the packed copy*/
+                                ReportedUntil = Packed + ( First->End - SrcOffset );
+                        }
+                }
+        }
+
+        std::swap( Previous, Current );
+}
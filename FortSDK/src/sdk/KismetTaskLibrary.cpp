@@ -0,0 +1,174 @@
+#include "pch.h"
+#include "../../include/SDK.h"
+
+void SDK::FKismetTaskLibrary::ScheduleNextTick( std::coroutine_handle<> Handle ) {
+        std::lock_guard<std::mutex> Guard( Lock );
+        Ready.push_back( Handle );
+        NumPending.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void SDK::FKismetTaskLibrary::RunOnGameThread( std::function<void()> Fn ) {
+        std::lock_guard<std::mutex> Guard( Lock );
+        Calls.push_back( std::move( Fn ) );
+        NumPending.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void SDK::FKismetTaskLibrary::WaitForObject( std::string Name, UClass *Class,
+                                             UObject **OutObject,
+                                             int32_t MaxTicks,
+                                             std::coroutine_handle<> Handle ) {
+        std::lock_guard<std::mutex> Guard( Lock );
+        ObjectWaiters.push_back(
+            { std::move( Name ), Class, OutObject, MaxTicks, Handle } );
+        bNewObjectWaiters = true;
+        NumPending.fetch_add( 1, std::memory_order_relaxed );
+}
+
+void SDK::FKismetTaskLibrary::Pump() {
+        GameThreadId.store( std::this_thread::get_id(),
+                            std::memory_order_relaxed );
+
+        /*Swap the lists out so anything scheduled while resuming waits for the next pump*/
+        std::vector<std::function<void()>> PumpCalls;
+        std::vector<std::coroutine_handle<>> PumpReady;
+        {
+                std::lock_guard<std::mutex> Guard( Lock );
+                PumpCalls.swap( Calls );
+                PumpReady.swap( Ready );
+        }
+        NumPending.fetch_sub( int32_t( PumpCalls.size() + PumpReady.size() ),
+                              std::memory_order_relaxed );
+
+        for ( auto &Call : PumpCalls )
+                Call();
+        for ( std::coroutine_handle<> Handle : PumpReady )
+                Handle.resume();
+
+        PumpObjectWaiters();
+}
+
+/**
+ * The FName a waiter is after, None while the name table doesn't have it yet.
+ * Comparing FNames is what keeps a scan free of one string per object.
+ */
+static SDK::FName ResolveWaitedName( const std::string &Name ) {
+        return SDK::FName( std::string_view( Name ), SDK::FNAME_Find );
+}
+
+namespace
+{
+/*Same hash the engine's name keyed maps are built with*/
+struct FNameHash {
+        size_t operator()( const SDK::FName &Name ) const { return GetTypeHash( Name ); }
+};
+
+/**
+ * Waiters keyed by the name they're after, so an object costs one lookup
+ * however many tasks wait. Without the engine's FName constructor the names
+ * can't be resolved up front and every object's name is spelled out into one
+ * reused buffer instead.
+ */
+class FWaitedNames
+{
+      public:
+        void Add( const std::string &Name, size_t WaiterIndex ) {
+                if ( !SDK::Offsets::FName__FName ) {
+                        ByString[Name].push_back( WaiterIndex );
+                        return;
+                }
+
+                /*Names nobody has added yet can't match anything this scan*/
+                const SDK::FName Wanted = ResolveWaitedName( Name );
+                if ( !Wanted.IsNone() )
+                        ByName[Wanted].push_back( WaiterIndex );
+        }
+
+        bool IsEmpty() const { return ByName.empty() && ByString.empty(); }
+
+        /*The waiters after Object's name, nullptr if there are none*/
+        const std::vector<size_t> *Find( SDK::UObject *Object ) {
+                if ( SDK::Offsets::FName__FName ) {
+                        auto Found = ByName.find( Object->GetFName() );
+                        return Found != ByName.end() ? &Found->second : nullptr;
+                }
+
+                Scratch.clear();
+                Object->GetFName().AppendString( Scratch );
+                auto Found = ByString.find( std::string_view( Scratch ) );
+                return Found != ByString.end() ? &Found->second : nullptr;
+        }
+
+      private:
+        std::unordered_map<SDK::FName, std::vector<size_t>, FNameHash> ByName;
+        SDK::TNameMap<std::vector<size_t>> ByString;
+        std::string Scratch;
+};
+}
+
+void SDK::FKismetTaskLibrary::PumpObjectWaiters() {
+        std::vector<FObjectWaiter> Waiters;
+        bool bNewWaiters = false;
+        {
+                std::lock_guard<std::mutex> Guard( Lock );
+                if ( ObjectWaiters.empty() )
+                        return;
+                Waiters.swap( ObjectWaiters );
+                bNewWaiters = bNewObjectWaiters;
+                bNewObjectWaiters = false;
+        }
+
+        /*Walking GUObjectArray is the expensive part, do it once for every waiter and not every tick*/
+        bool bScan = bNewWaiters || ++PumpsSinceScan >= ObjectScanInterval;
+        for ( const FObjectWaiter &Waiter : Waiters )
+                bScan |= Waiter.TicksLeft == 1;
+
+        if ( bScan ) {
+                PumpsSinceScan = 0;
+
+                FWaitedNames WaitedNames;
+                for ( size_t i = 0; i < Waiters.size(); i++ )
+                        WaitedNames.Add( Waiters[i].Name, i );
+
+                const int32 NumObjects = GUObjectArray.GetObjectArrayNum();
+                for ( int32 i = 0; i < NumObjects && !WaitedNames.IsEmpty(); i++ ) {
+                        FUObjectItem *ObjectItem = GUObjectArray.IndexToObject( i );
+                        if ( !ObjectItem || !ObjectItem->Object )
+                                continue;
+
+                        UObject *Object =
+                            static_cast<UObject *>( ObjectItem->Object );
+                        const std::vector<size_t> *Found = WaitedNames.Find( Object );
+                        if ( !Found )
+                                continue;
+
+                        for ( size_t Index : *Found ) {
+                                FObjectWaiter &Waiter = Waiters[Index];
+                                if ( !*Waiter.OutObject &&
+                                     ( !Waiter.Class || Object->IsA( Waiter.Class ) ) )
+                                        *Waiter.OutObject = Object;
+                        }
+                }
+        }
+
+        std::vector<FObjectWaiter> StillWaiting;
+        std::vector<std::coroutine_handle<>> Resume;
+        for ( FObjectWaiter &Waiter : Waiters ) {
+                if ( *Waiter.OutObject ||
+                     ( Waiter.TicksLeft > 0 && --Waiter.TicksLeft == 0 ) )
+                        Resume.push_back( Waiter.Handle );
+                else
+                        StillWaiting.push_back( std::move( Waiter ) );
+        }
+
+        {
+                std::lock_guard<std::mutex> Guard( Lock );
+                ObjectWaiters.insert( ObjectWaiters.end(),
+                                      std::make_move_iterator( StillWaiting.begin() ),
+                                      std::make_move_iterator( StillWaiting.end() ) );
+        }
+        NumPending.fetch_sub( int32_t( Resume.size() ),
+                              std::memory_order_relaxed );
+
+        for ( std::coroutine_handle<> Handle : Resume )
+                Handle.resume();
+}
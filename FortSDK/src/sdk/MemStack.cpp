@@ -0,0 +1,61 @@
+#include "pch.h"
+#include "../../include/SDK.h"
+
+SDK::FMemStack &SDK::FMemStack::Get() {
+        static thread_local FMemStack ThreadStack;
+        return ThreadStack;
+}
+
+SDK::FMemStack::~FMemStack() {
+        FreeChunks( nullptr );
+
+        while ( UnusedChunks ) {
+                FChunk *Next = UnusedChunks->Next;
+                free( UnusedChunks );
+                UnusedChunks = Next;
+        }
+}
+
+void SDK::FMemStack::AllocateNewChunk( size_t MinSize ) {
+        FChunk *Chunk = nullptr;
+
+        if ( MinSize <= DefaultChunkSize && UnusedChunks ) {
+                Chunk = UnusedChunks;
+                UnusedChunks = Chunk->Next;
+        } else {
+                const size_t DataSize = ( std::max )( MinSize, DefaultChunkSize );
+                Chunk = static_cast<FChunk *>(
+                    malloc( sizeof( FChunk ) + DataSize ) );
+                if ( !Chunk ) {
+                        UE_LOG( LogFortSDK, Fatal,
+                                "FMemStack failed to allocate a %zu byte chunk",
+                                DataSize );
+                        std::abort();
+                }
+                Chunk->DataSize = DataSize;
+        }
+
+        Chunk->Next = TopChunk;
+        TopChunk = Chunk;
+        Top = Chunk->Data();
+        End = Top + Chunk->DataSize;
+}
+
+void SDK::FMemStack::FreeChunks( FChunk *NewTopChunk ) {
+        while ( TopChunk != NewTopChunk ) {
+                FChunk *Chunk = TopChunk;
+                TopChunk = Chunk->Next;
+
+                /*Oversized chunks came from one big push, don't keep them around*/
+                if ( Chunk->DataSize > DefaultChunkSize ) {
+                        free( Chunk );
+                        continue;
+                }
+
+                Chunk->Next = UnusedChunks;
+                UnusedChunks = Chunk;
+        }
+
+        Top = nullptr;
+        End = nullptr;
+}
@@ -0,0 +1,247 @@
+#include "pch.h"
+#include "../../include/SDK.h"
+
+namespace
+{
+using FReallocFn = void *( * )( void *Original, UINT64 Size, UINT32 Alignment );
+
+/*FMalloc members, GMalloc goes in as this*/
+using FMallocFn = void *( * )( void *GMalloc, UINT64 Count, UINT32 Alignment );
+using FFreeFn = void ( * )( void *GMalloc, void *Original );
+using FQuantizeSizeFn = UINT64 ( * )( void *GMalloc, UINT64 Count, UINT32 Alignment );
+using FGetAllocationSizeFn = bool ( * )( void *GMalloc, void *Original,
+                                         UINT64 &SizeOut );
+
+std::atomic<uint64_t> AllocatedBytes = 0;
+std::atomic<uint64_t> Allocations = 0;
+std::atomic<uint64_t> Frees = 0;
+std::atomic<uint64_t> LiveBytes = 0;
+
+/**
+ * Blocks the SDK allocated and hasn't freed yet, with the size they were
+ * counted as. Frees of anything else (an FString the engine returned, say)
+ * leave the counters alone. Sharded by address so threads allocating at once
+ * rarely wait on each other.
+ */
+class FLiveBlocks
+{
+      public:
+        void Add( void *Ptr, uint64_t Size ) {
+                FShard &Shard = GetShard( Ptr );
+                std::lock_guard Guard( Shard.Lock );
+                Shard.Blocks.insert_or_assign( Ptr, Size );
+        }
+
+        bool Remove( void *Ptr, uint64_t &OutSize ) {
+                FShard &Shard = GetShard( Ptr );
+                std::lock_guard Guard( Shard.Lock );
+                auto Found = Shard.Blocks.find( Ptr );
+                if ( Found == Shard.Blocks.end() )
+                        return false;
+                OutSize = Found->second;
+                Shard.Blocks.erase( Found );
+                return true;
+        }
+
+      private:
+        static constexpr size_t NumShards = 16;
+
+        struct FShard {
+                std::mutex Lock;
+                std::unordered_map<void *, uint64_t> Blocks;
+        };
+
+        FShard &GetShard( void *Ptr ) {
+                return Shards[std::hash<void *>{}( Ptr ) % NumShards];
+        }
+
+        FShard Shards[NumShards];
+};
+
+FLiveBlocks &GetLiveBlocks() {
+        static FLiveBlocks Blocks;
+        return Blocks;
+}
+
+FORCEINLINE void *GetGMalloc() {
+        return *reinterpret_cast<void **>( SDK::Offsets::GMalloc );
+}
+
+/*Live bytes go by what the allocator really handed out when GetAllocSize is resolved*/
+void CountAllocation( void *Ptr, UINT64 Requested ) {
+        if ( !Ptr )
+                return;
+        uint64_t Size = SDK::FMemory::GetAllocSize( Ptr );
+        if ( !Size )
+                Size = Requested;
+
+        GetLiveBlocks().Add( Ptr, Size );
+        AllocatedBytes.fetch_add( Requested, std::memory_order_relaxed );
+        Allocations.fetch_add( 1, std::memory_order_relaxed );
+        LiveBytes.fetch_add( Size, std::memory_order_relaxed );
+}
+
+/*Before the block goes back, the allocator may hand the same address out again right after*/
+bool CountFree( void *Ptr ) {
+        uint64_t Size = 0;
+        if ( !GetLiveBlocks().Remove( Ptr, Size ) )
+                return false;
+        Frees.fetch_add( 1, std::memory_order_relaxed );
+        LiveBytes.fetch_sub( Size, std::memory_order_relaxed );
+        return true;
+}
+
+bool IsInModule( uint64_t Address, const MODULEINFO &Module ) {
+        const uint64_t Base = uint64_t( Module.lpBaseOfDll );
+        return Address >= Base && Address < Base + Module.SizeOfImage;
+}
+}
+
+void *SDK::FMemory::Malloc( UINT64 Count, UINT32 Alignment ) {
+        void *Result = nullptr;
+        if ( Offsets::FMemory__Malloc )
+                Result = reinterpret_cast<FMallocFn>( Offsets::FMemory__Malloc )(
+                    GetGMalloc(), Count, Alignment );
+        else if ( Offsets::FMemory__Realloc )
+                Result = reinterpret_cast<FReallocFn>( Offsets::FMemory__Realloc )(
+                    nullptr, Count, Alignment );
+
+        CountAllocation( Result, Count );
+        return Result;
+}
+
+void *SDK::FMemory::Realloc( void *Original, UINT64 Size, UINT32 Alignment ) {
+        if ( !Offsets::FMemory__Realloc )
+                return nullptr;
+
+        /*Growing one of the engine's own blocks doesn't make it the SDK's*/
+        const bool bOwned = Original && CountFree( Original );
+        void *Result = reinterpret_cast<FReallocFn>( Offsets::FMemory__Realloc )(
+            Original, Size, Alignment );
+        if ( !Original || bOwned )
+                CountAllocation( Result, Size );
+        return Result;
+}
+
+void SDK::FMemory::Free( void *Original ) {
+        /*Before Init there's nothing to free with, leaking is the only option*/
+        if ( !Original || ( !Offsets::FMemory__Free && !Offsets::FMemory__Realloc ) )
+                return;
+
+        CountFree( Original );
+        if ( Offsets::FMemory__Free )
+                reinterpret_cast<FFreeFn>( Offsets::FMemory__Free )( GetGMalloc(),
+                                                                     Original );
+        else
+                reinterpret_cast<FReallocFn>( Offsets::FMemory__Realloc )( Original, 0,
+                                                                           0 );
+}
+
+UINT64 SDK::FMemory::GetAllocSize( void *Original ) {
+        UINT64 Size = 0;
+        if ( !Original || !Offsets::FMemory__GetAllocSize )
+                return 0;
+
+        if ( !reinterpret_cast<FGetAllocationSizeFn>( Offsets::FMemory__GetAllocSize )(
+                 GetGMalloc(), Original, Size ) )
+                return 0;
+        return Size;
+}
+
+UINT64 SDK::FMemory::QuantizeSize( UINT64 Count, UINT32 Alignment ) {
+        if ( !Offsets::FMemory__QuantizeSize )
+                return Count;
+        return reinterpret_cast<FQuantizeSizeFn>( Offsets::FMemory__QuantizeSize )(
+            GetGMalloc(), Count, Alignment );
+}
+
+SDK::FMemoryStats SDK::FMemory::GetStats() {
+        return { AllocatedBytes.load( std::memory_order_relaxed ),
+                 Allocations.load( std::memory_order_relaxed ),
+                 Frees.load( std::memory_order_relaxed ),
+                 LiveBytes.load( std::memory_order_relaxed ) };
+}
+
+bool SDK::FMemory::ResolveFromRealloc() {
+        const uint8_t *Code =
+            reinterpret_cast<const uint8_t *>( Offsets::FMemory__Realloc );
+        if ( !Code )
+                return false;
+
+        /*FMemory::Realloc loads GMalloc rip relative, then calls [reg+Slot*8] on its vtable*/
+        uint64_t GMallocAddress = 0;
+        int32_t ReallocSlot = -1;
+        for ( int32_t i = 0; i < 0x100 && ReallocSlot < 0; i++ ) {
+                if ( !GMallocAddress ) {
+                        if ( ( Code[i] == 0x48 || Code[i] == 0x4C ) &&
+                             Code[i + 1] == 0x8B && ( Code[i + 2] & 0xC7 ) == 0x05 ) {
+                                GMallocAddress =
+                                    uint64_t( Code + i + 7 ) +
+                                    *reinterpret_cast<const int32_t *>( Code + i + 3 );
+                                i += 6;
+                        }
+                        continue;
+                }
+
+                /*FF /2 with a disp8 or disp32, skipping the SIB forms*/
+                if ( Code[i] != 0xFF || ( Code[i + 1] & 7 ) == 4 )
+                        continue;
+                if ( ( Code[i + 1] & 0xF8 ) == 0x50 )
+                        ReallocSlot = Code[i + 2] / 8;
+                else if ( ( Code[i + 1] & 0xF8 ) == 0x90 )
+                        ReallocSlot = *reinterpret_cast<const int32_t *>( Code + i + 2 ) / 8;
+        }
+
+        /*Slot 0 and 1 are the destructor and FExec::Exec*/
+        if ( !GMallocAddress || ReallocSlot < 3 || ReallocSlot > 16 )
+                return false;
+
+        MODULEINFO Module{};
+        if ( !GetModuleInformation( GetCurrentProcess(), GetModuleHandle( 0 ), &Module,
+                                    sizeof( Module ) ) )
+                return false;
+        if ( !IsInModule( GMallocAddress, Module ) )
+                return false;
+
+        void *GMalloc = *reinterpret_cast<void **>( GMallocAddress );
+        if ( !GMalloc )
+                return false;
+        const uint64_t *VTable = *reinterpret_cast<const uint64_t **>( GMalloc );
+        if ( !IsInModule( uint64_t( VTable ), Module ) )
+                return false;
+
+        /*Realloc right after Malloc is the layout from before TryMalloc/TryRealloc, either way Malloc and Free sit around it*/
+        const int32_t Step = ReallocSlot > 3 ? 2 : 1;
+        const int32_t FreeSlot = ReallocSlot + Step;
+        const uint64_t MallocFunc = VTable[ReallocSlot - Step];
+        const uint64_t FreeFunc = VTable[FreeSlot];
+        if ( !IsInModule( MallocFunc, Module ) || !IsInModule( FreeFunc, Module ) )
+                return false;
+
+        Offsets::GMalloc = GMallocAddress;
+        Offsets::FMemory__Malloc = MallocFunc;
+        Offsets::FMemory__Free = FreeFunc;
+
+        /*What follows Free depends on the engine version, and any function in the
+         * module passes IsInModule, so these are only taken where the layout is known:
+         *   before 5.0: Free, QuantizeSize, GetAllocationSize
+         *   5.1 on:     Free, MallocZeroed, TryMallocZeroed, QuantizeSize, GetAllocationSize
+         * 5.0 is left alone, QuantizeSize and GetAllocSize fall back without them*/
+        int32_t QuantizeSizeSlot = -1;
+        if ( Engine_Version >= FEngineVersion( 5, 1, 0 ) )
+                QuantizeSizeSlot = FreeSlot + 3;
+        else if ( Engine_Version < FEngineVersion( 5, 0, 0 ) &&
+                  Engine_Version >= FEngineVersion( 4, 0, 0 ) )
+                QuantizeSizeSlot = FreeSlot + 1;
+
+        if ( QuantizeSizeSlot > 0 ) {
+                const uint64_t QuantizeSizeFunc = VTable[QuantizeSizeSlot];
+                const uint64_t GetAllocationSizeFunc = VTable[QuantizeSizeSlot + 1];
+                if ( IsInModule( QuantizeSizeFunc, Module ) &&
+                     IsInModule( GetAllocationSizeFunc, Module ) ) {
+                        Offsets::FMemory__QuantizeSize = QuantizeSizeFunc;
+                        Offsets::FMemory__GetAllocSize = GetAllocationSizeFunc;
+                }
+        }
+        return true;
+}
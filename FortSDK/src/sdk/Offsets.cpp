@@ -2,8 +2,14 @@
 #include "../../include/SDK.h"
 
 uint64_t SDK::Offsets::GUObjectArray__ObjObjects = 0;
+uint64_t SDK::Offsets::FUObjectArray__AllocateSerialNumber = 0;
 uint64_t SDK::Offsets::FName__ToString = 0;
+uint64_t SDK::Offsets::FName__FName = 0;
 uint64_t SDK::Offsets::FMemory__Realloc = 0;
 uint64_t SDK::Offsets::FMemory__Free = 0;
+uint64_t SDK::Offsets::FMemory__Malloc = 0;
+uint64_t SDK::Offsets::FMemory__QuantizeSize = 0;
+uint64_t SDK::Offsets::FMemory__GetAllocSize = 0;
+uint64_t SDK::Offsets::GMalloc = 0;
 uint32_t SDK::Offsets::Members::UFunction__Exec = -1;
 uint64_t SDK::Offsets::UObject__ProcessEvent = 0;
\ No newline at end of file
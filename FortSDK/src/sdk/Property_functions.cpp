@@ -0,0 +1,152 @@
+#include "pch.h"
+#include "../../include/SDK.h"
+
+/*Most specific first, a ClassProperty also carries the ObjectProperty flag*/
+static constexpr std::pair<SDK::uint64, SDK::EPropertyType> PropertyTypeTable[] = {
+    { SDK::CASTCLASS_FBoolProperty, SDK::EPropertyType::Bool },
+    { SDK::CASTCLASS_FInt8Property, SDK::EPropertyType::Int8 },
+    { SDK::CASTCLASS_FByteProperty, SDK::EPropertyType::Byte },
+    { SDK::CASTCLASS_FInt16Property, SDK::EPropertyType::Int16 },
+    { SDK::CASTCLASS_FUInt16Property, SDK::EPropertyType::UInt16 },
+    { SDK::CASTCLASS_FIntProperty, SDK::EPropertyType::Int },
+    { SDK::CASTCLASS_FUInt32Property, SDK::EPropertyType::UInt32 },
+    { SDK::CASTCLASS_FInt64Property, SDK::EPropertyType::Int64 },
+    { SDK::CASTCLASS_FUInt64Property, SDK::EPropertyType::UInt64 },
+    { SDK::CASTCLASS_FFloatProperty, SDK::EPropertyType::Float },
+    { SDK::CASTCLASS_FDoubleProperty, SDK::EPropertyType::Double },
+    { SDK::CASTCLASS_FNameProperty, SDK::EPropertyType::Name },
+    { SDK::CASTCLASS_FStrProperty, SDK::EPropertyType::Str },
+    { SDK::CASTCLASS_FTextProperty, SDK::EPropertyType::Text },
+    { SDK::CASTCLASS_FClassProperty, SDK::EPropertyType::Class },
+    { SDK::CASTCLASS_FSoftClassProperty, SDK::EPropertyType::SoftClass },
+    { SDK::CASTCLASS_FObjectProperty, SDK::EPropertyType::Object },
+    { SDK::CASTCLASS_FWeakObjectProperty, SDK::EPropertyType::WeakObject },
+    { SDK::CASTCLASS_FLazyObjectProperty, SDK::EPropertyType::LazyObject },
+    { SDK::CASTCLASS_FSoftObjectProperty, SDK::EPropertyType::SoftObject },
+    { SDK::CASTCLASS_FInterfaceProperty, SDK::EPropertyType::Interface },
+    { SDK::CASTCLASS_FStructProperty, SDK::EPropertyType::Struct },
+    { SDK::CASTCLASS_FArrayProperty, SDK::EPropertyType::Array },
+    { SDK::CASTCLASS_FMapProperty, SDK::EPropertyType::Map },
+    { SDK::CASTCLASS_FSetProperty, SDK::EPropertyType::Set },
+    { SDK::CASTCLASS_FEnumProperty, SDK::EPropertyType::Enum },
+    { SDK::CASTCLASS_FDelegateProperty, SDK::EPropertyType::Delegate },
+    { SDK::CASTCLASS_FMulticastDelegateProperty,
+      SDK::EPropertyType::MulticastDelegate },
+    { SDK::CASTCLASS_FFieldPathProperty, SDK::EPropertyType::FieldPath },
+};
+
+/*UProperty classes don't expose their cast flags in a place we know, so they're rebuilt from the class names*/
+static const std::unordered_map<std::string_view, SDK::uint64> UPropertyCastFlags = {
+    { "Property", SDK::CASTCLASS_FProperty },
+    { "NumericProperty", SDK::CASTCLASS_FNumericProperty },
+    { "BoolProperty", SDK::CASTCLASS_FBoolProperty },
+    { "Int8Property", SDK::CASTCLASS_FInt8Property },
+    { "ByteProperty", SDK::CASTCLASS_FByteProperty },
+    { "Int16Property", SDK::CASTCLASS_FInt16Property },
+    { "UInt16Property", SDK::CASTCLASS_FUInt16Property },
+    { "IntProperty", SDK::CASTCLASS_FIntProperty },
+    { "UInt32Property", SDK::CASTCLASS_FUInt32Property },
+    { "Int64Property", SDK::CASTCLASS_FInt64Property },
+    { "UInt64Property", SDK::CASTCLASS_FUInt64Property },
+    { "FloatProperty", SDK::CASTCLASS_FFloatProperty },
+    { "DoubleProperty", SDK::CASTCLASS_FDoubleProperty },
+    { "NameProperty", SDK::CASTCLASS_FNameProperty },
+    { "StrProperty", SDK::CASTCLASS_FStrProperty },
+    { "TextProperty", SDK::CASTCLASS_FTextProperty },
+    { "ObjectPropertyBase", SDK::CASTCLASS_FObjectPropertyBase },
+    { "ObjectProperty", SDK::CASTCLASS_FObjectProperty },
+    { "ClassProperty", SDK::CASTCLASS_FClassProperty },
+    { "WeakObjectProperty", SDK::CASTCLASS_FWeakObjectProperty },
+    { "LazyObjectProperty", SDK::CASTCLASS_FLazyObjectProperty },
+    { "SoftObjectProperty", SDK::CASTCLASS_FSoftObjectProperty },
+    { "SoftClassProperty", SDK::CASTCLASS_FSoftClassProperty },
+    { "InterfaceProperty", SDK::CASTCLASS_FInterfaceProperty },
+    { "StructProperty", SDK::CASTCLASS_FStructProperty },
+    { "ArrayProperty", SDK::CASTCLASS_FArrayProperty },
+    { "MapProperty", SDK::CASTCLASS_FMapProperty },
+    { "SetProperty", SDK::CASTCLASS_FSetProperty },
+    { "EnumProperty", SDK::CASTCLASS_FEnumProperty },
+    { "DelegateProperty", SDK::CASTCLASS_FDelegateProperty },
+    { "MulticastDelegateProperty", SDK::CASTCLASS_FMulticastDelegateProperty },
+    { "MulticastInlineDelegateProperty",
+      SDK::CASTCLASS_FMulticastInlineDelegateProperty },
+    { "MulticastSparseDelegateProperty",
+      SDK::CASTCLASS_FMulticastSparseDelegateProperty },
+};
+
+static SDK::uint64 GetUPropertyClassCastFlags( SDK::UClass *Class ) {
+        static std::unordered_map<SDK::UClass *, SDK::uint64> Cache;
+        static std::shared_mutex CacheLock;
+
+        {
+                std::shared_lock Lock( CacheLock );
+                auto Found = Cache.find( Class );
+                if ( Found != Cache.end() )
+                        return Found->second;
+        }
+
+        /*Cast flags are inherited, so or in every class up the chain*/
+        SDK::uint64 Flags = SDK::CASTCLASS_None;
+        for ( SDK::UStruct *Struct = Class; Struct;
+              Struct = Struct->GetSuperStruct() ) {
+                auto Found = UPropertyCastFlags.find(
+                    Struct->GetFName().ToString().ToString() );
+                if ( Found != UPropertyCastFlags.end() )
+                        Flags |= Found->second;
+        }
+
+        std::unique_lock Lock( CacheLock );
+        Cache.try_emplace( Class, Flags );
+        return Flags;
+}
+
+static SDK::EPropertyType GetPropertyType( SDK::uint64 CastFlags ) {
+        for ( const auto &[Flag, Type] : PropertyTypeTable ) {
+                if ( CastFlags & Flag )
+                        return Type;
+        }
+        return SDK::EPropertyType::Unknown;
+}
+
+SDK::FPropertyRef::FPropertyRef( void *InProp ) : Prop( InProp ) {
+        if ( !Prop )
+                return;
+
+        FKismetPropertyManager Manager{ Prop };
+        Offset = Manager.GetOffset();
+        ElementSize = Manager.GetElementSize();
+        ArrayDim = Manager.GetArrayDim();
+
+        if ( UEChanges::bUsesFPropertySystem ) {
+                FField *Field = static_cast<FField *>( Prop );
+                CastFlags = Field->ClassPrivate ? Field->ClassPrivate->CastFlags
+                                                : CASTCLASS_None;
+        } else {
+                CastFlags = GetUPropertyClassCastFlags(
+                    static_cast<UProperty *>( Prop )->GetClass() );
+        }
+        Type = GetPropertyType( CastFlags );
+}
+
+SDK::EPropertyFlags SDK::FPropertyRef::GetPropertyFlags() const {
+        return FKismetPropertyManager{ Prop }.GetPropertyFlags();
+}
+
+std::string SDK::FPropertyRef::GetName() const {
+        return FKismetPropertyManager{ Prop }.GetName();
+}
+
+SDK::uint32 SDK::FPropertyRef::GetSubclassMembersOffset() {
+        if ( !UEChanges::bUsesFPropertySystem )
+                return sizeof( UProperty );
+        /*Offset_Internal, RepNotifyFunc and the four link pointers*/
+        if ( UEChanges::bUsesUE5FProp )
+                return FProperty500::OffsetInternalOffset + 0x2C;
+        return sizeof( FProperty );
+}
+
+SDK::FPropertyRef SDK::FArrayPropertyRef::GetInner() const {
+        /*UE5 moved ArrayFlags in front of Inner*/
+        return FPropertyRef( ReadMember<void *>(
+            Engine_Version >= FEngineVersion( 5, 0, 0 ) ? 8 : 0 ) );
+}
@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "../../include/SDK.h"
+
+namespace
+{
+bool IsReadableProtection( DWORD Protect ) {
+        if ( Protect & ( PAGE_GUARD | PAGE_NOACCESS ) )
+                return false;
+        return ( Protect & ( PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY |
+                             PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE |
+                             PAGE_EXECUTE_WRITECOPY ) ) != 0;
+}
+
+/*No C++ objects in here, SEH can't unwind them*/
+bool GuardedCopy( void *Dest, const void *Source, size_t Size ) {
+#ifdef _MSC_VER
+        __try {
+                std::memcpy( Dest, Source, Size );
+        } __except ( EXCEPTION_EXECUTE_HANDLER ) {
+                return false;
+        }
+#else
+        std::memcpy( Dest, Source, Size );
+#endif
+        return true;
+}
+}
+
+SDK::FReadableMemoryMap &SDK::FReadableMemoryMap::Get() {
+        static FReadableMemoryMap Map;
+        return Map;
+}
+
+int32_t SDK::FReadableMemoryMap::FindRegion( uintptr_t Address ) const {
+        auto Found = std::upper_bound(
+            Regions.begin(), Regions.end(), Address,
+            []( uintptr_t Address, const FRegion &Region ) { return Address < Region.Start; } );
+        if ( Found == Regions.begin() )
+                return INDEX_NONE;
+        --Found;
+        return Address < Found->End ? int32_t( Found - Regions.begin() ) : INDEX_NONE;
+}
+
+SDK::FReadableMemoryMap::FRegion
+SDK::FReadableMemoryMap::QueryRegion( uintptr_t Address ) const {
+        MEMORY_BASIC_INFORMATION Info{};
+        if ( !VirtualQuery( reinterpret_cast<void *>( Address ), &Info, sizeof( Info ) ) ) {
+                /*Past the top of user space, cache one page of nothing*/
+                return { Address, Address + 0x1000, GetTickCount64() + RefreshIntervalMs, false };
+        }
+
+        const uintptr_t Start = uintptr_t( Info.BaseAddress );
+        return { Start, Start + Info.RegionSize, GetTickCount64() + RefreshIntervalMs,
+                 Info.State == MEM_COMMIT && IsReadableProtection( Info.Protect ) };
+}
+
+void SDK::FReadableMemoryMap::StoreRegion( const FRegion &Region ) {
+        std::unique_lock Guard( Lock );
+
+        /*Whatever overlaps the fresh result is out of date*/
+        auto First = std::lower_bound(
+            Regions.begin(), Regions.end(), Region.Start,
+            []( const FRegion &Other, uintptr_t Start ) { return Other.End <= Start; } );
+        auto Last = First;
+        while ( Last != Regions.end() && Last->Start < Region.End )
+                ++Last;
+
+        Regions.insert( Regions.erase( First, Last ), Region );
+}
+
+bool SDK::FReadableMemoryMap::IsReadable( const void *Address, size_t Size ) {
+        uintptr_t Current = uintptr_t( Address );
+        const uintptr_t End = Current + Size;
+        if ( !Current || End < Current )
+                return false;
+
+        const uint64_t Now = GetTickCount64();
+        do {
+                bool bFound = false;
+                FRegion Region{};
+                {
+                        std::shared_lock Guard( Lock );
+                        const int32_t Index = FindRegion( Current );
+                        if ( Index != INDEX_NONE && Regions[Index].ExpiresAt > Now ) {
+                                Region = Regions[Index];
+                                bFound = true;
+                        }
+                }
+
+                if ( !bFound ) {
+                        Region = QueryRegion( Current );
+                        StoreRegion( Region );
+                }
+
+                if ( !Region.bReadable )
+                        return false;
+                Current = Region.End;
+        } while ( Current < End );
+
+        return true;
+}
+
+void SDK::FReadableMemoryMap::Invalidate( const void *Address ) {
+        std::unique_lock Guard( Lock );
+        const int32_t Index = FindRegion( uintptr_t( Address ) );
+        if ( Index != INDEX_NONE )
+                Regions.erase( Regions.begin() + Index );
+}
+
+bool SDK::FReadableMemoryMap::SafeCopy( void *Dest, const void *Source, size_t Size ) {
+        if ( !IsReadable( Source, Size ) )
+                return false;
+
+        if ( !GuardedCopy( Dest, Source, Size ) ) {
+                Invalidate( Source );
+                return false;
+        }
+        return true;
+}
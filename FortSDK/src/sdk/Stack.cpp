@@ -0,0 +1,155 @@
+#include "pch.h"
+#include "../../include/SDK.h"
+
+namespace
+{
+/*Stands in for every FOutputDevice virtual, the thunks only reach them when logging a script error*/
+uint64_t NativeFrameStubVirtual() { return 0; }
+
+void *NativeFrameVTable[16] = {
+    &NativeFrameStubVirtual, &NativeFrameStubVirtual, &NativeFrameStubVirtual,
+    &NativeFrameStubVirtual, &NativeFrameStubVirtual, &NativeFrameStubVirtual,
+    &NativeFrameStubVirtual, &NativeFrameStubVirtual, &NativeFrameStubVirtual,
+    &NativeFrameStubVirtual, &NativeFrameStubVirtual, &NativeFrameStubVirtual,
+    &NativeFrameStubVirtual, &NativeFrameStubVirtual, &NativeFrameStubVirtual,
+    &NativeFrameStubVirtual };
+
+/*FlowStack is a TArray<uint32, TInlineAllocator<8>>, 8 inline elements and the heap pointer before Num and Max*/
+constexpr SDK::uint32 FlowStackNumInline = 8;
+constexpr SDK::uint32 FlowStackArrayMax = FlowStackNumInline * sizeof( SDK::uint32 ) +
+                                     sizeof( void * ) + sizeof( SDK::int32 );
+constexpr SDK::uint32 FlowStackSize = FlowStackArrayMax + sizeof( SDK::int32 );
+}
+
+const SDK::FFrameLayout &SDK::FFrameLayout::Get() {
+        static const FFrameLayout Layout = [] {
+                FFrameLayout L{};
+                /*vtable, bSuppressEventTag and bAutoEmitLineTerminator from FOutputDevice*/
+                L.Node = 0x10;
+                L.Object = L.Node + sizeof( void * );
+                L.Code = L.Object + sizeof( void * );
+                L.Locals = L.Code + sizeof( void * );
+                /*MostRecentProperty, MostRecentPropertyAddress and since 5.1 MostRecentPropertyContainer*/
+                L.FlowStack = L.Locals + sizeof( void * ) * ( Engine_Version >= FEngineVersion( 5, 1, 0 ) ? 4 : 3 );
+                L.PreviousFrame = L.FlowStack + FlowStackSize;
+                L.OutParms = L.PreviousFrame + sizeof( void * );
+                L.PropertyChainForCompiledIn = L.OutParms + sizeof( void * );
+                L.CurrentNativeFunction =
+                    L.PropertyChainForCompiledIn + sizeof( void * );
+                /*bArrayContextFailed and bAbortingExecution, padded*/
+                L.Size = L.CurrentNativeFunction + sizeof( void * ) * 2;
+                return L;
+        }();
+        return Layout;
+}
+
+SDK::FNativeFrame::FNativeFrame( const UObject *Object, UFunction *Function,
+                                 uint8 *Locals, FOutParmRec *OutParms ) {
+        const FFrameLayout &Layout = FFrameLayout::Get();
+        std::memset( Data, 0, Layout.Size );
+
+        Write<void *>( 0, NativeFrameVTable );
+        Write( Layout.Node, Function );
+        Write( Layout.Object, Object );
+        Write<uint8 *>( Layout.Code, nullptr );
+        Write( Layout.Locals, Locals );
+        Write<int32>( Layout.FlowStack + FlowStackArrayMax, FlowStackNumInline );
+        Write( Layout.OutParms, OutParms );
+        Write<void *>( Layout.PropertyChainForCompiledIn,
+                       UEChanges::bUsesFPropertySystem
+                           ? static_cast<void *>(
+                                 Function->GetChildrenProperties() )
+                           : static_cast<void *>( Function->GetChildren() ) );
+        Write( Layout.CurrentNativeFunction, Function );
+}
+
+bool SDK::UFunction::CanInvokeNative() {
+        if ( !HasAnyFunctionFlags( FUNC_Native ) ||
+             HasAnyFunctionFlags( FUNC_Net | FUNC_BlueprintEvent |
+                                  FUNC_Delegate ) ||
+             !GetNativeFunc() )
+                return false;
+
+        static UClass *InterfaceClass = StaticClassImpl( "Interface" );
+        UClass *OuterClass = static_cast<UClass *>( GetOuter() );
+        return !InterfaceClass || !OuterClass ||
+               !OuterClass->IsChildOf( InterfaceClass );
+}
+
+void SDK::UObject::InvokeNative( UFunction *Function, void *Parms ) const {
+        InvokeNative( Function, Parms,
+                      PropLibrary->GetFunctionParamsInfo( Function ) );
+}
+
+void SDK::UObject::InvokeNative( UFunction *Function, void *Parms,
+                                 const FFunctionParamsInfo *ParamsInfo ) const {
+        uint8 *Locals = static_cast<uint8 *>( Parms );
+
+        /*Same chain ProcessEvent builds, every CPF_OutParm including the return value*/
+        FOutParmRec OutRecs[64];
+        FOutParmRec *OutParms = nullptr;
+        FOutParmRec **LastOut = &OutParms;
+        int32 NumOut = 0;
+        auto AddOutParm = [&]( const FParamInfo &Param ) {
+                if ( !Param.IsOut() || NumOut >= 64 )
+                        return;
+                FOutParmRec &Out = OutRecs[NumOut++];
+                Out.Property = Param.Prop;
+                Out.PropAddr = Locals + Param.Offset;
+                Out.NextOutParm = nullptr;
+                *LastOut = &Out;
+                LastOut = &Out.NextOutParm;
+        };
+        for ( const FParamInfo &Param : ParamsInfo->Params )
+                AddOutParm( Param );
+        if ( ParamsInfo->ReturnValue.Offset != -1 )
+                AddOutParm( ParamsInfo->ReturnValue );
+
+        FNativeFrame Frame( this, Function, Locals, OutParms );
+        void *Result = ParamsInfo->ReturnValue.Offset != -1
+                           ? Locals + ParamsInfo->ReturnValue.Offset
+                           : nullptr;
+        Function->GetNativeFunc()( const_cast<UObject *>( this ), Frame.Get(),
+                                   Result );
+}
+
+SDK::FNativeInvokeTimings SDK::BenchmarkNativeInvoke( UObject *Object,
+                                                      UFunction *Function,
+                                                      int32 Iterations ) {
+        FNativeInvokeTimings Timings;
+        if ( !Object || !Function || Iterations <= 0 )
+                return Timings;
+
+        if ( !Function->CanInvokeNative() ) {
+                UE_LOG( LogFortSDK, Warning,
+                        "BenchmarkNativeInvoke: %s can't be invoked natively",
+                        Function->GetFName().ToString().ToString().c_str() );
+                return Timings;
+        }
+
+        const FFunctionParamsInfo *ParamsInfo =
+            PropLibrary->GetFunctionParamsInfo( Function );
+        FFunctionParamsFrame Frame( ParamsInfo );
+
+        /*CanInvokeNative already required FUNC_Native, nothing to force*/
+        auto Start = std::chrono::steady_clock::now();
+        for ( int32 i = 0; i < Iterations; i++ )
+                Object->ProcessEvent( Function, Frame.GetData() );
+        auto Mid = std::chrono::steady_clock::now();
+        for ( int32 i = 0; i < Iterations; i++ )
+                Object->InvokeNative( Function, Frame.GetData(), ParamsInfo );
+        auto End = std::chrono::steady_clock::now();
+
+        Timings.ProcessEventNs =
+            std::chrono::duration<double, std::nano>( Mid - Start ).count() /
+            Iterations;
+        Timings.NativeInvokeNs =
+            std::chrono::duration<double, std::nano>( End - Mid ).count() /
+            Iterations;
+
+        UE_LOG( LogFortSDK, Log,
+                "%s: ProcessEvent %.1fns, InvokeNative %.1fns (%d calls)",
+                Function->GetFName().ToString().ToString().c_str(),
+                Timings.ProcessEventNs, Timings.NativeInvokeNs, Iterations );
+        return Timings;
+}